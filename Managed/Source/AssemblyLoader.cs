@@ -28,7 +28,9 @@ namespace DotOther.Managed {
     private static readonly Dictionary<Type, AsmLoadStatus> load_errors = new();
     private static readonly Dictionary<Int32, AssemblyLoadContext> contexts = new();
     private static readonly Dictionary<Int32, Assembly> assemblies = new();
-    private static Dictionary<Int32, List<GCHandle>> handles = new();
+    /// handles given to native per assembly, and the assembly each one was filed under
+    private static readonly Dictionary<Int32, HashSet<IntPtr>> handles = new();
+    private static readonly Dictionary<IntPtr, Int32> handle_owners = new();
 
     private static AsmLoadStatus last_load_status = AsmLoadStatus.Success;
 #nullable enable
@@ -57,24 +59,29 @@ namespace DotOther.Managed {
 
 #nullable enable
     internal static bool TryGetAssembly(Int32 id , out Assembly? asm) {
-      return assemblies.TryGetValue(id, out asm);
+      lock (assemblies) {
+        return assemblies.TryGetValue(id, out asm);
+      }
     }
 
     internal static Assembly? ResolveAssembly(AssemblyLoadContext? context, AssemblyName asm_name) {
       try {
         Int32 asm_id = asm_name.Name!.GetHashCode();
-        if (assemblies.TryGetValue(asm_id, out var asm)) {
-          return asm;
-        }
+        /// reflection resolves references from every native import worker at once
+        lock (assemblies) {
+          if (assemblies.TryGetValue(asm_id, out var asm)) {
+            return asm;
+          }
 
-        foreach (var alc in contexts.Values) {
-          foreach (var assembly  in alc.Assemblies) {
-            if (assembly.GetName().Name != asm_name.Name) {
-              continue;
-            }
+          foreach (var alc in contexts.Values) {
+            foreach (var assembly  in alc.Assemblies) {
+              if (assembly.GetName().Name != asm_name.Name) {
+                continue;
+              }
 
-            assemblies.Add(asm_id, assembly);
-            return assembly;
+              assemblies.Add(asm_id, assembly);
+              return assembly;
+            }
           }
         }
       } catch (Exception e) {
@@ -85,7 +92,7 @@ namespace DotOther.Managed {
     }
 
     [UnmanagedCallersOnly]
-    private static Int32 CreateAssemblyLoadContext(NString context_name) {
+    internal static Int32 CreateAssemblyLoadContext(NString context_name) {
       string? name = context_name;
 
       if (name == null) {
@@ -99,7 +106,9 @@ namespace DotOther.Managed {
         foreach (var asm in ctx.Assemblies) {
           var asm_name = asm.GetName();
           Int32 asm_id = asm_name.Name!.GetHashCode();
-          assemblies.Remove(asm_id);
+          lock (assemblies) {
+            assemblies.Remove(asm_id);
+          }
         }
       };
 
@@ -109,43 +118,120 @@ namespace DotOther.Managed {
       return ctx_id;
     }
 
-    
-	  [UnmanagedCallersOnly]
-	  private static void UnloadAssemblyLoadContext(Int32 context_id) {
-      if (!contexts.TryGetValue(context_id, out var alc)) {
-        LogMessage($"Cannot unload AssemblyLoadContext '{context_id}', it was either never loaded or already unloaded.", MessageLevel.Warning);
-        return;
+    /// Collectible context a reflection object's ids belong to, or null for the shared partition (the default
+    ///   context and CoreLib are never unloaded). Constructed types belong to the first collectible context among
+    ///   their definition and arguments, List<PluginType> goes away with the plugin.
+    internal static AssemblyLoadContext? OwningContext(Type type) {
+      if (type.HasElementType) {
+        return OwningContext(type.GetElementType()!);
       }
 
-      if (alc == null) {
-        LogMessage($"AssemblyLoadContext '{context_id}' was found in dictionary but was null. This is most likely a bug.", MessageLevel.Error);
-        return;
+      if (type.IsConstructedGenericType) {
+        var owner = OwningContext(type.GetGenericTypeDefinition());
+        foreach (var arg in type.GenericTypeArguments) {
+          owner ??= OwningContext(arg);
+        }
+        return owner;
       }
 
-      foreach (var assembly in alc.Assemblies) {
-        var asm_name = assembly.GetName();
-        int asm_id = asm_name.Name!.GetHashCode();
+      return OwningContext(type.Assembly);
+    }
 
-        if (!handles.TryGetValue(asm_id, out var hs)) {
-          continue;
+    internal static AssemblyLoadContext? OwningContext(MemberInfo member) {
+      if (member is MethodInfo { IsConstructedGenericMethod: true } method) {
+        foreach (var arg in method.GetGenericArguments()) {
+          if (OwningContext(arg) is AssemblyLoadContext owner) {
+            return owner;
+          }
+        }
+      }
+
+      /// a base class member reached through a plugin type is a distinct object reflected from it, it goes with the
+      ///   plugin even when the declaring type is shared
+      Type? reflected = member.ReflectedType ?? member.DeclaringType;
+      if (reflected == null) {
+        return OwningContext(member.Module.Assembly);
+      }
+      return OwningContext(reflected) ?? (member.DeclaringType != null ? OwningContext(member.DeclaringType) : null);
+    }
+
+    /// context of whatever an attribute was read from, types and members resolve differently
+    internal static AssemblyLoadContext? OwningContext(ICustomAttributeProvider target) {
+      return target switch {
+        Type type => OwningContext(type),
+        MemberInfo member => OwningContext(member),
+        _ => null,
+      };
+    }
+
+    private static AssemblyLoadContext? OwningContext(Assembly asm) {
+      var alc = AssemblyLoadContext.GetLoadContext(asm);
+      return alc is { IsCollectible: true } ? alc : null;
+    }
+
+	  [UnmanagedCallersOnly]
+	  internal static unsafe void UnloadAssemblyLoadContext(Int32 context_id, IntPtr* out_evicted, Int32* out_count) {
+      try {
+        if (out_evicted != null) {
+          *out_evicted = IntPtr.Zero;
+        }
+        if (out_count != null) {
+          *out_count = 0;
         }
 
-        foreach (var h in hs) {
-          if (!h.IsAllocated || h.Target == null) {
-            continue;
+        if (!contexts.TryGetValue(context_id, out var alc)) {
+          LogMessage($"Cannot unload AssemblyLoadContext '{context_id}', it was either never loaded or already unloaded.", MessageLevel.Warning);
+          return;
+        }
+
+        if (alc == null) {
+          LogMessage($"AssemblyLoadContext '{context_id}' was found in dictionary but was null. This is most likely a bug.", MessageLevel.Error);
+          return;
+        }
+
+        foreach (var assembly in alc.Assemblies) {
+          var asm_name = assembly.GetName();
+          int asm_id = asm_name.Name!.GetHashCode();
+
+          lock (handles) {
+            if (!handles.Remove(asm_id, out var hs)) {
+              continue;
+            }
+
+            foreach (var h in hs) {
+              handle_owners.Remove(h);
+              GCHandle.FromIntPtr(h).Free();
+            }
+          }
+        }
+
+        /// only this context's ids go, every other context keeps resolving the ids it was handed
+        var evicted = InteropInterface.cached_types.ClearPartition(alc);
+        InteropInterface.cached_methods.ClearPartition(alc);
+        InteropInterface.cached_fields.ClearPartition(alc);
+        InteropInterface.cached_properties.ClearPartition(alc);
+        InteropInterface.cached_attributes.ClearPartition(alc);
+        ManagedObject.ForgetContext(alc);
+
+        var evicted_set = new HashSet<Int32>(evicted);
+        foreach (var (key, id) in InteropInterface.generic_types) {
+          if (evicted_set.Contains(id) || evicted_set.Contains(key.definition) || key.args.Any(evicted_set.Contains)) {
+            InteropInterface.generic_types.TryRemove(key, out _);
           }
-          h.Free();
         }
-      }
 
-      InteropInterface.cached_types.Clear();
-      InteropInterface.cached_methods.Clear();
-      InteropInterface.cached_fields.Clear();
-      InteropInterface.cached_properties.Clear();
-      InteropInterface.cached_attributes.Clear();
+        contexts.Remove(context_id);
+        alc.Unload();
 
-      contexts.Remove(context_id);
-      alc.Unload();
+        if (out_evicted != null && out_count != null && evicted.Count > 0) {
+          IntPtr mem = Marshal.AllocHGlobal(evicted.Count * sizeof(Int32));
+          evicted.CopyTo(new Span<Int32>(mem.ToPointer(), evicted.Count));
+          *out_evicted = mem;
+          *out_count = evicted.Count;
+        }
+      } catch (Exception e) {
+        HandleException(e);
+      }
     }
 
     static Assembly? dotother_assembly = null;
@@ -268,7 +354,8 @@ namespace DotOther.Managed {
     }
     
     [UnmanagedCallersOnly]
-    private static int LoadAssembly(int context_id, NString file_path) {
+    internal static int LoadAssembly(int context_id, NString file_path) {
+      using var timing = StartupTimings.Measure(ManagedPhase.LoadAssembly);
       try {
         LogMessage($"Loading assembly '{file_path}' [{context_id}]", MessageLevel.Trace);
 
@@ -314,7 +401,9 @@ namespace DotOther.Managed {
         
         Int32 asm_id = name.Name!.GetHashCode();
         try {
-          assemblies.Add(asm_id, asm);
+          lock (assemblies) {
+            assemblies.Add(asm_id, asm);
+          }
         } catch (Exception e) {
           last_load_status = AsmLoadStatus.Failed;
           HandleException(e);
@@ -331,11 +420,11 @@ namespace DotOther.Managed {
     }
 
     [UnmanagedCallersOnly]
-    private static AsmLoadStatus GetLastLoadStatus() => last_load_status;
+    internal static AsmLoadStatus GetLastLoadStatus() => last_load_status;
 
     [UnmanagedCallersOnly]
-    private static NString GetAsmName(Int32 asm_id) {
-      if (!assemblies.TryGetValue(asm_id, out var asm)) {
+    internal static NString GetAsmName(Int32 asm_id) {
+      if (!TryGetAssembly(asm_id, out var asm) || asm == null) {
         LogMessage($"Couldn't get assembly name for assembly '{asm_id}', assembly not found!", MessageLevel.Error);
         return "<unknown>";
       }
@@ -347,13 +436,33 @@ namespace DotOther.Managed {
     internal static void RegisterHandle(Assembly asm , GCHandle handle) {
       var asm_name = asm.GetName();
       Int32 asm_id = asm_name.Name!.GetHashCode();
+      IntPtr ptr = GCHandle.ToIntPtr(handle);
+
+      lock (handles) {
+        if (!handles.TryGetValue(asm_id , out var hs)) {
+          hs = new HashSet<IntPtr>();
+          handles.Add(asm_id, hs);
+        }
 
-      if (!handles.TryGetValue(asm_id , out var hs)) {
-        handles.Add(asm_id, new List<GCHandle>());
-        hs = handles[asm_id];
+        hs.Add(ptr);
+        handle_owners[ptr] = asm_id;
+      }
+    }
+
+    /// frees a handle native is done with, false if it was never registered or its context already freed it
+    internal static bool ReleaseHandle(IntPtr ptr) {
+      lock (handles) {
+        if (!handle_owners.Remove(ptr, out var asm_id)) {
+          return false;
+        }
+
+        if (handles.TryGetValue(asm_id, out var hs)) {
+          hs.Remove(ptr);
+        }
       }
 
-      hs.Add(handle);
+      GCHandle.FromIntPtr(ptr).Free();
+      return true;
     }
 #nullable disable
   }
@@ -0,0 +1,132 @@
+using System;
+using System.Collections.Generic;
+using System.Reflection;
+using System.Runtime.InteropServices;
+using System.Text;
+
+using DotOther.Managed.Interop;
+
+namespace DotOther.Managed {
+
+  /// Every primitive and string field of one attribute instance in a single block, mirrored by hosting/attribute.cpp.
+  ///
+  /// Layout: a Header, Count packed Records and a string table of { UInt32 length, UTF-8 bytes } entries. Record
+  ///   names and string values are offsets into the string table. Integers are widened to 64 bits (signed ones
+  ///   sign-extended), floats keep their IEEE bits and enums are stored as their underlying type.
+  internal static class AttributeSnapshot {
+    [StructLayout(LayoutKind.Sequential, Pack = 1)]
+    internal struct Header {
+      public UInt32 Size;
+      public UInt32 Count;
+      public UInt32 Strings;
+      public UInt32 Reserved;
+    }
+
+    [StructLayout(LayoutKind.Sequential, Pack = 1)]
+    internal struct Record {
+      public UInt32 Name;
+      public Int32 Kind;
+      public UInt64 Value;
+    }
+
+    /// GetFields leaves out private fields of base classes, each class of the hierarchy is asked for its own
+    private const BindingFlags kFieldFlags = BindingFlags.Public | BindingFlags.NonPublic | BindingFlags.Instance | BindingFlags.DeclaredOnly;
+
+#nullable enable
+    private sealed class StringTable {
+      internal readonly List<byte> bytes = new();
+      private readonly Dictionary<string, UInt32> offsets = new();
+
+      internal UInt32 Intern(string? str) {
+        str ??= string.Empty;
+        if (offsets.TryGetValue(str, out var offset)) {
+          return offset;
+        }
+
+        offset = (UInt32)bytes.Count;
+        byte[] utf8 = Encoding.UTF8.GetBytes(str);
+        bytes.AddRange(BitConverter.GetBytes((UInt32)utf8.Length));
+        bytes.AddRange(utf8);
+
+        offsets[str] = offset;
+        return offset;
+      }
+    }
+
+    /// auto-property backing fields are reported under the property's name
+    private static string DisplayName(FieldInfo field) {
+      string name = field.Name;
+      if (name.StartsWith('<')) {
+        Int32 end = name.IndexOf(">k__BackingField", StringComparison.Ordinal);
+        if (end > 1) {
+          return name.Substring(1, end - 1);
+        }
+      }
+      return name;
+    }
+
+    private static UInt64 Bits(object? value, ManagedType kind) {
+      if (value == null) {
+        return 0;
+      }
+
+      if (value is Enum) {
+        value = Convert.ChangeType(value, Enum.GetUnderlyingType(value.GetType()));
+      }
+
+      return kind switch {
+        ManagedType.Bool => value is NBool32 nbool ? ((bool)nbool ? 1ul : 0ul) : ((bool)value ? 1ul : 0ul),
+        ManagedType.Float => BitConverter.SingleToUInt32Bits((float)value),
+        ManagedType.Double => BitConverter.DoubleToUInt64Bits((double)value),
+        ManagedType.SByte or ManagedType.Short or ManagedType.Int or ManagedType.Long => unchecked((UInt64)Convert.ToInt64(value)),
+        _ => Convert.ToUInt64(value),
+      };
+    }
+
+    private static bool IsSnapshotKind(ManagedType kind) {
+      return kind is >= ManagedType.SByte and <= ManagedType.Bool || kind == ManagedType.String;
+    }
+
+    /// builds the block into HGlobal memory owned by the caller
+    internal static unsafe IntPtr Build(Attribute attribute, out Int32 size) {
+      var records = new List<Record>();
+      var strings = new StringTable();
+
+      /// most derived class first, a field hidden by a derived one of the same name is found second
+      for (Type? type = attribute.GetType(); type != null && type != typeof(Attribute); type = type.BaseType) {
+        foreach (var field in type.GetFields(kFieldFlags)) {
+          ManagedType kind = MethodSignature.KindOf(field.FieldType);
+          if (!IsSnapshotKind(kind)) {
+            continue;
+          }
+
+          object? value = field.GetValue(attribute);
+          records.Add(new Record {
+            Name = strings.Intern(DisplayName(field)),
+            Kind = (Int32)kind,
+            Value = kind == ManagedType.String ? strings.Intern(value is NString nstring ? nstring : value as string) : Bits(value, kind),
+          });
+        }
+      }
+
+      Int32 records_size = records.Count * sizeof(Record);
+      size = sizeof(Header) + records_size + strings.bytes.Count;
+
+      IntPtr mem = Marshal.AllocHGlobal(size);
+      byte* dest = (byte*)mem.ToPointer();
+
+      *(Header*)dest = new Header {
+        Size = (UInt32)size,
+        Count = (UInt32)records.Count,
+        Strings = (UInt32)(sizeof(Header) + records_size),
+      };
+
+      CollectionsMarshal.AsSpan(records).CopyTo(new Span<Record>(dest + sizeof(Header), records.Count));
+      CollectionsMarshal.AsSpan(strings.bytes).CopyTo(new Span<byte>(dest + sizeof(Header) + records_size, strings.bytes.Count));
+
+      return mem;
+    }
+#nullable disable
+  }
+
+}
@@ -6,7 +6,7 @@ namespace DotOther {
   using static DotOtherHost;
 
   public class Host {
-    public static NObject GetNativeObject(UInt64 internal_id) {
+    public static NObject? GetNativeObject(UInt64 internal_id) {
       try {
         return DotOtherHost.GetNativeObject(internal_id);
       } catch (Exception e) {
@@ -1,4 +1,6 @@
 using System;
+using System.Collections.Concurrent;
+using System.Reflection;
 using System.Runtime.InteropServices;
 using System.Text;
 
@@ -22,7 +24,7 @@ namespace DotOther.Managed {
     public unsafe delegate*<NString , void> ExceptionCallback;
     public unsafe delegate*<NString , MessageLevel, void> LogCallback;
     public unsafe delegate*<UInt64, NString, void> NativeMethodInvoker;
-    public unsafe delegate*<NObject,UInt64> RetrieveNativeObject;
+    public unsafe delegate*<UInt64, IntPtr> RetrieveNativeObject;
   }
 
 
@@ -31,17 +33,21 @@ namespace DotOther.Managed {
     private static unsafe delegate*<NString , MessageLevel, void> LogCallback;
 
     private static unsafe delegate*<UInt64, NString, void> NativeMethodInvoker;
-    private static unsafe delegate*<NObject,UInt64> RetrieveNativeObject;
+    private static unsafe delegate*<UInt64, IntPtr> RetrieveNativeObject;
 
     [UnmanagedCallersOnly]
     private static unsafe void EntryPoint(DotOtherArgs args) {
+      using var timing = StartupTimings.Measure(ManagedPhase.EntryPoint);
+
       ExceptionCallback = args.ExceptionCallback;
       LogCallback = args.LogCallback;
       NativeMethodInvoker = args.NativeMethodInvoker;
       RetrieveNativeObject = args.RetrieveNativeObject;
       LogCallback("DotOtherHost: Initialized", MessageLevel.Info);
 
-      AssemblyLoader.LoadNetCoreAssemblies();
+      using (StartupTimings.Measure(ManagedPhase.NetCoreAssemblies)) {
+        AssemblyLoader.LoadNetCoreAssemblies();
+      }
     }
 
     internal static void LogMessage(string message, MessageLevel level) {
@@ -77,24 +83,47 @@ namespace DotOther.Managed {
       }
     }
 
-    internal static NObject GetNativeObject(UInt64 handle) {
+    /// managed wrappers for native objects, keyed by the native object_handle and dropped when native unregisters
+    private static readonly ConcurrentDictionary<UInt64, NObject> native_objects = new();
+
+    /// null for handle 0 and for handles native has no object registered under
+    internal static NObject? GetNativeObject(UInt64 handle) => GetNativeObject(handle, typeof(NObject));
+
+    internal static NObject? GetNativeObject(UInt64 handle, Type type) {
       if (handle == 0) {
         return null;
       }
 
+      if (native_objects.TryGetValue(handle, out var obj) && type.IsInstanceOfType(obj)) {
+        return obj;
+      }
+
       unsafe {
-        if (GetNativeObject == null) {
-          LogMessage("GetNativeObject is null", MessageLevel.Error);
-          throw new InvalidOperationException("GetNativeObject is null");
+        if (RetrieveNativeObject == null) {
+          LogMessage("RetrieveNativeObject is null", MessageLevel.Error);
+          throw new InvalidOperationException("RetrieveNativeObject is null");
         }
 
-        try {
-          return GetNativeObject(handle);
-        } catch (Exception e) {
-          HandleException(e);
+        if (RetrieveNativeObject(handle) == IntPtr.Zero) {
+          LogMessage($"Native object {handle:x} is not registered", MessageLevel.Error);
           return null;
         }
       }
+
+      NObject? created = type == typeof(NObject) ?
+        new NObject(handle) :
+        Activator.CreateInstance(type, BindingFlags.Public | BindingFlags.NonPublic | BindingFlags.Instance, null, new object[] { handle }, null) as NObject;
+      if (created == null) {
+        LogMessage($"Couldn't wrap native object {handle:x}, '{type.FullName}' is not an NObject", MessageLevel.Error);
+        return null;
+      }
+
+      native_objects[handle] = created;
+      return created;
+    }
+
+    internal static void ReleaseNativeObject(UInt64 handle) {
+      native_objects.TryRemove(handle, out _);
     }
   }
 
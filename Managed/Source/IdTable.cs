@@ -0,0 +1,136 @@
+using System;
+using System.Collections.Generic;
+using System.Threading;
+
+namespace DotOther.Managed {
+
+  /// Dense ids for reflection objects handed to native. An id is an index into an append-only array and a
+  ///   reference-equality map gives each object exactly one id, so distinct objects never share one and TryGet
+  ///   is a bounds check and a load.
+  ///
+  /// Id 0 is never handed out, native reads it as "no object". Cleared ids are not reused, an id native still
+  ///   holds after a Clear resolves to nothing rather than to another object. Add takes a lock, TryGet does not.
+  ///
+  /// A table built with a partition function files every id under the partition its object belongs to, so one
+  ///   partition can be dropped without touching ids handed out for the others. A null partition is shared and
+  ///   only goes away with Clear.
+#nullable enable
+  public class IdTable<T> where T : class {
+    private T?[] elements = new T?[64];
+    private Int32 count = 1;
+    private Int32 live = 0;
+    private readonly Dictionary<T, Int32> ids = new(ReferenceEqualityComparer.Instance);
+    private readonly Func<T, object?>? partition_of = null;
+    private readonly Dictionary<object, List<Int32>> partitions = new(ReferenceEqualityComparer.Instance);
+    private readonly object write_lock = new();
+
+    public IdTable() {}
+
+    public IdTable(Func<T, object?> partition_of) {
+      this.partition_of = partition_of;
+    }
+
+    public bool Contains(Int32 id) {
+      return TryGet(id, out _);
+    }
+
+    public Int32 Size {
+      get {
+        return Volatile.Read(ref live);
+      }
+    }
+
+    public IEnumerable<T> Elements {
+      get {
+        T?[] snapshot = Volatile.Read(ref elements);
+        Int32 end = Math.Min(Volatile.Read(ref count), snapshot.Length);
+        for (Int32 i = 1; i < end; i++) {
+          if (snapshot[i] is T element) {
+            yield return element;
+          }
+        }
+      }
+    }
+
+    public Int32 Add(T? element) {
+      return Add(element, partition_of, null);
+    }
+
+    /// files a new id under partition instead of asking the table's partition function, for objects whose owner
+    ///   is not reachable from the object itself
+    public Int32 Add(T? element, object? partition) {
+      return Add(element, null, partition);
+    }
+
+    private Int32 Add(T? element, Func<T, object?>? partition_fn, object? partition) {
+      if (element == null) {
+        throw new ArgumentNullException(nameof(element));
+      }
+
+      lock (write_lock) {
+        if (ids.TryGetValue(element, out var id)) {
+          return id;
+        }
+
+        id = count;
+        if (id == elements.Length) {
+          /// readers keep using the old array until the grown one is published, both hold every live id
+          var grown = new T?[elements.Length * 2];
+          Array.Copy(elements, grown, elements.Length);
+          Volatile.Write(ref elements, grown);
+        }
+
+        elements[id] = element;
+        ids[element] = id;
+
+        if ((partition_fn != null ? partition_fn(element) : partition) is object owner) {
+          if (!partitions.TryGetValue(owner, out var members)) {
+            members = new List<Int32>();
+            partitions.Add(owner, members);
+          }
+          members.Add(id);
+        }
+
+        live++;
+        Volatile.Write(ref count, id + 1);
+        return id;
+      }
+    }
+
+    public bool TryGet(Int32 id, out T? element) {
+      T?[] snapshot = Volatile.Read(ref elements);
+      element = (UInt32)id < (UInt32)Math.Min(Volatile.Read(ref count), snapshot.Length) ? snapshot[id] : null;
+      return element != null;
+    }
+
+    public void Clear() {
+      lock (write_lock) {
+        Array.Clear(elements);
+        ids.Clear();
+        partitions.Clear();
+        live = 0;
+      }
+    }
+
+    /// drops every id filed under partition and returns them, ids in other partitions stay valid
+    public List<Int32> ClearPartition(object partition) {
+      lock (write_lock) {
+        if (!partitions.Remove(partition, out var members)) {
+          return new List<Int32>();
+        }
+
+        foreach (var id in members) {
+          if (elements[id] is T element) {
+            ids.Remove(element);
+            elements[id] = null;
+            live--;
+          }
+        }
+
+        return members;
+      }
+    }
+  }
+#nullable disable
+
+}
@@ -71,7 +71,7 @@ namespace DotOther.Managed.Interop {
     }
 
     [UnmanagedCallersOnly]
-    private static unsafe void SetInternalCalls(IntPtr internall_calls, int length) {
+    internal static unsafe void SetInternalCalls(IntPtr internall_calls, int length) {
       var calls = new NArray<InternalCall>(internall_calls, length);
 
       try {
@@ -85,7 +85,7 @@ namespace DotOther.Managed.Interop {
     }
 
     [UnmanagedCallersOnly]
-    private static unsafe void SetInternalCall(InternalCall internal_call) {
+    internal static unsafe void SetInternalCall(InternalCall internal_call) {
       try {
         RegisterInternalCall(internal_call);
       } catch (Exception ex) {
@@ -0,0 +1,200 @@
+using System;
+using System.Reflection;
+using System.Runtime.InteropServices;
+
+using DotOther.Managed.Interop;
+
+namespace DotOther.Managed {
+
+  using static DotOtherHost;
+
+  /// Mirrors interface_bindings::FunctionTable in hosting/interop_interface.hpp, entry for entry and in the same
+  ///   order. Bump Version whenever an entry is added, removed or changes signature on either side.
+  [StructLayout(LayoutKind.Sequential)]
+  internal unsafe struct FunctionTable {
+    internal const UInt32 Version = 3;
+
+    public UInt32 TableVersion;
+    public UInt32 TableSize;
+
+    public delegate* unmanaged<NString, Int32> CreateAssemblyLoadContext;
+    public delegate* unmanaged<Int32, IntPtr*, Int32*, void> UnloadAssemblyLoadContext;
+    public delegate* unmanaged<Int32, NString, Int32> LoadAssembly;
+    public delegate* unmanaged<AsmLoadStatus> GetLastLoadStatus;
+    public delegate* unmanaged<Int32, NString> GetAssemblyName;
+    public delegate* unmanaged<Int32*, Int32*, void> GetNetCoreTypes;
+    public delegate* unmanaged<Int32, Int32*, Int32*, void> GetAsmTypes;
+    public delegate* unmanaged<NString, Int32*, void> GetTypeId;
+    public delegate* unmanaged<Int32, Int32*, Int32, Int32*, void> MakeGenericType;
+    public delegate* unmanaged<Int32, NString> GetFullTypeName;
+    public delegate* unmanaged<Int32, NString> GetAsmQualifiedName;
+    public delegate* unmanaged<Int32, Int32*, void> GetBaseType;
+    public delegate* unmanaged<Int32, Int32> GetTypeSize;
+    public delegate* unmanaged<Int32, Int32, NBool32> IsTypeDerivedFrom;
+    public delegate* unmanaged<Int32, Int32, NBool32> IsAssignableTo;
+    public delegate* unmanaged<Int32, Int32, NBool32> IsAssignableFrom;
+    public delegate* unmanaged<Int32, NBool32> IsTypeSzArray;
+    public delegate* unmanaged<Int32, Int32*, void> GetElementType;
+    public delegate* unmanaged<Int32, Int32*, Int32*, void> GetTypeMethods;
+    public delegate* unmanaged<Int32, Int32*, Int32*, void> GetTypeFields;
+    public delegate* unmanaged<Int32, Int32*, Int32*, void> GetTypeProperties;
+    public delegate* unmanaged<Int32, Int32, NBool32> HasTypeAttribute;
+    public delegate* unmanaged<Int32, Int32*, Int32*, void> GetTypeAttributes;
+    public delegate* unmanaged<Int32, ManagedType> GetTypeManagedType;
+    public delegate* unmanaged<Int32, IntPtr*, Int32*, void> ExportAssemblyMetadata;
+    public delegate* unmanaged<Int32, IntPtr, Int32, Int32*, Int32, NBool32> BindAssemblyMetadata;
+    public delegate* unmanaged<Int32, IntPtr, Int32, Int32, Int32*, Int32, NBool32> BindTypeMembers;
+    public delegate* unmanaged<Int32, MetadataExport.CacheKey*, void> GetMetadataKey;
+    public delegate* unmanaged<Int32, Int32*, NString> GetFieldName;
+    public delegate* unmanaged<Int32, Int32*, void> GetFieldType;
+    public delegate* unmanaged<Int32, InteropInterface.TypeAccessibility> GetFieldAccessibility;
+    public delegate* unmanaged<Int32, Int32*, Int32*, void> GetFieldAttributes;
+    public delegate* unmanaged<Int32, Int32*, NString> GetPropertyName;
+    public delegate* unmanaged<Int32, Int32*, void> GetPropertyType;
+    public delegate* unmanaged<Int32, Int32*, Int32*, void> GetPropertyAttributes;
+    public delegate* unmanaged<Int32, NString, IntPtr, void> GetAttrValue;
+    public delegate* unmanaged<Int32, Int32*, void> GetAttrType;
+    public delegate* unmanaged<Int32, IntPtr*, Int32*, void> GetAttrSnapshot;
+    public delegate* unmanaged<Int32, NString> GetMethodName;
+    public delegate* unmanaged<Int32, Int32*, void> GetMethodReturnType;
+    public delegate* unmanaged<Int32, Int32*, Int32*, void> GetMethodParamTypes;
+    public delegate* unmanaged<Int32, Int32*, Int32*, void> GetMethodAttributes;
+    public delegate* unmanaged<Int32, InteropInterface.TypeAccessibility> GetMethodAccessibility;
+    public delegate* unmanaged<Int32, UInt64> GetMethodSignature;
+    public delegate* unmanaged<IntPtr, Int32, void> SetInternalCalls;
+    public delegate* unmanaged<InternalCall, void> SetInternalCall;
+    public delegate* unmanaged<Int32, NBool32, IntPtr, UInt64, Int32, IntPtr> CreateObject;
+    public delegate* unmanaged<IntPtr, void> DestroyObject;
+    public delegate* unmanaged<UInt64, void> ReleaseNativeObject;
+    public delegate* unmanaged<IntPtr, NString, IntPtr, UInt64, Int32, void> InvokeMethod;
+    public delegate* unmanaged<IntPtr, NString, IntPtr, UInt64, Int32, IntPtr, void> InvokeMethodRet;
+    public delegate* unmanaged<Int32, NString, IntPtr, UInt64, Int32, void> InvokeStaticMethod;
+    public delegate* unmanaged<Int32, NString, IntPtr, UInt64, Int32, IntPtr, void> InvokeStaticMethodRet;
+    public delegate* unmanaged<IntPtr, NString, IntPtr, void> SetField;
+    public delegate* unmanaged<IntPtr, NString, IntPtr, void> GetField;
+    public delegate* unmanaged<IntPtr, NString, IntPtr, void> SetProperty;
+    public delegate* unmanaged<IntPtr, NString, IntPtr, void> GetProperty;
+    public delegate* unmanaged<Int32, GCCollectionMode, NBool32, NBool32, void> CollectGarbage;
+    public delegate* unmanaged<void> WaitForPendingFinalizers;
+    public delegate* unmanaged<Int64*, Int32, void> GetStartupTimings;
+  }
+
+  /// One call hands native every interop entry point, instead of one hostfxr lookup per function.
+  internal static class InteropBootstrap {
+    /// Mirrors interface_bindings::EntryTag, FNV-1a of the entry name with underscores dropped and letters lowered
+    private static UInt64 EntryTag(string name) {
+      UInt64 hash = 14695981039346656037;
+      foreach (char c in name) {
+        if (c == '_') {
+          continue;
+        }
+
+        hash ^= (byte)char.ToLowerInvariant(c);
+        hash *= 1099511628211;
+      }
+      return hash;
+    }
+
+    /// native stamps every slot with the tag of the entry it expects there, a field declared out of order here
+    ///   would otherwise be filled with another entry's function without either side noticing
+    private static unsafe bool EntriesMatch(FunctionTable* table) {
+      foreach (var field in typeof(FunctionTable).GetFields(BindingFlags.Public | BindingFlags.Instance)) {
+        if (!field.FieldType.IsFunctionPointer) {
+          continue;
+        }
+
+        nuint slot = *(nuint*)((byte*)table + Marshal.OffsetOf<FunctionTable>(field.Name));
+        if (slot != (nuint)EntryTag(field.Name)) {
+          LogMessage($"Function table entry '{field.Name}' does not line up with the native layout", MessageLevel.Critical);
+          return false;
+        }
+      }
+      return true;
+    }
+
+    [UnmanagedCallersOnly]
+    private static unsafe NBool32 FillFunctionTable(FunctionTable* table) {
+      try {
+        if (table == null) {
+          throw new ArgumentNullException(nameof(table));
+        }
+
+        /// native stamps its own layout, a host built against another table must not be handed this one
+        if (table->TableVersion != FunctionTable.Version || table->TableSize != sizeof(FunctionTable)) {
+          LogMessage($"Function table mismatch, native v{table->TableVersion} ({table->TableSize} bytes), managed v{FunctionTable.Version} ({sizeof(FunctionTable)} bytes)", MessageLevel.Critical);
+          return false;
+        }
+
+        if (!EntriesMatch(table)) {
+          return false;
+        }
+
+        table->CreateAssemblyLoadContext = &AssemblyLoader.CreateAssemblyLoadContext;
+        table->UnloadAssemblyLoadContext = &AssemblyLoader.UnloadAssemblyLoadContext;
+        table->LoadAssembly = &AssemblyLoader.LoadAssembly;
+        table->GetLastLoadStatus = &AssemblyLoader.GetLastLoadStatus;
+        table->GetAssemblyName = &AssemblyLoader.GetAsmName;
+        table->GetNetCoreTypes = &InteropInterface.GetNetCoreTypes;
+        table->GetAsmTypes = &InteropInterface.GetAsmTypes;
+        table->GetTypeId = &InteropInterface.GetTypeId;
+        table->MakeGenericType = &InteropInterface.MakeGenericType;
+        table->GetFullTypeName = &InteropInterface.GetFullTypeName;
+        table->GetAsmQualifiedName = &InteropInterface.GetAsmQualifiedName;
+        table->GetBaseType = &InteropInterface.GetBaseType;
+        table->GetTypeSize = &InteropInterface.GetTypeSize;
+        table->IsTypeDerivedFrom = &InteropInterface.IsTypeDerivedFrom;
+        table->IsAssignableTo = &InteropInterface.IsAssignableTo;
+        table->IsAssignableFrom = &InteropInterface.IsAssignableFrom;
+        table->IsTypeSzArray = &InteropInterface.IsSzArray;
+        table->GetElementType = &InteropInterface.GetElementType;
+        table->GetTypeMethods = &InteropInterface.GetTypeMethods;
+        table->GetTypeFields = &InteropInterface.GetTypeFields;
+        table->GetTypeProperties = &InteropInterface.GetTypeProperties;
+        table->HasTypeAttribute = &InteropInterface.HasAttribute;
+        table->GetTypeAttributes = &InteropInterface.GetAttributes;
+        table->GetTypeManagedType = &InteropInterface.GetTypeManagedType;
+        table->ExportAssemblyMetadata = &MetadataExport.ExportAssemblyMetadata;
+        table->BindAssemblyMetadata = &MetadataExport.BindAssemblyMetadata;
+        table->BindTypeMembers = &MetadataExport.BindTypeMembers;
+        table->GetMetadataKey = &MetadataExport.GetMetadataKey;
+        table->GetFieldName = &InteropInterface.GetFieldName;
+        table->GetFieldType = &InteropInterface.GetFieldType;
+        table->GetFieldAccessibility = &InteropInterface.GetFieldAccessibility;
+        table->GetFieldAttributes = &InteropInterface.GetFieldAttributes;
+        table->GetPropertyName = &InteropInterface.GetPropertyName;
+        table->GetPropertyType = &InteropInterface.GetPropertyType;
+        table->GetPropertyAttributes = &InteropInterface.GetPropertyAttributes;
+        table->GetAttrValue = &InteropInterface.GetAttributeValue;
+        table->GetAttrType = &InteropInterface.GetAttributeType;
+        table->GetAttrSnapshot = &InteropInterface.GetAttributeSnapshot;
+        table->GetMethodName = &InteropInterface.GetMethodName;
+        table->GetMethodReturnType = &InteropInterface.GetMethodReturnType;
+        table->GetMethodParamTypes = &InteropInterface.GetMethodParameterTypes;
+        table->GetMethodAttributes = &InteropInterface.GetMethodAttributes;
+        table->GetMethodAccessibility = &InteropInterface.GetMethodAccessibility;
+        table->GetMethodSignature = &InteropInterface.GetMethodSignature;
+        table->SetInternalCalls = &InternalCallManager.SetInternalCalls;
+        table->SetInternalCall = &InternalCallManager.SetInternalCall;
+        table->CreateObject = &ManagedObject.CreateObject;
+        table->DestroyObject = &ManagedObject.DestroyObject;
+        table->ReleaseNativeObject = &ManagedObject.ReleaseNativeObject;
+        table->InvokeMethod = &ManagedObject.InvokeMethod;
+        table->InvokeMethodRet = &ManagedObject.InvokeMethodRet;
+        table->InvokeStaticMethod = &ManagedObject.InvokeStaticMethod;
+        table->InvokeStaticMethodRet = &ManagedObject.InvokeStaticMethodRet;
+        table->SetField = &ManagedObject.SetField;
+        table->GetField = &ManagedObject.GetField;
+        table->SetProperty = &ManagedObject.SetProperty;
+        table->GetProperty = &ManagedObject.GetProperty;
+        table->CollectGarbage = &GarbageCollector.CollectGarbage;
+        table->WaitForPendingFinalizers = &GarbageCollector.WaitForPendingFinalizers;
+        table->GetStartupTimings = &StartupTimings.GetStartupTimings;
+        return true;
+      } catch (Exception e) {
+        HandleException(e);
+        return false;
+      }
+    }
+  }
+
+}
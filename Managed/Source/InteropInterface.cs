@@ -1,4 +1,5 @@
 using System;
+using System.Collections.Concurrent;
 using System.Collections.Generic;
 using System.Collections.Immutable;
 using System.Reflection;
@@ -11,26 +12,17 @@ namespace DotOther.Managed {
 	using static DotOtherHost;
 
 	internal static class InteropInterface {
-		internal readonly static Set<Type> cached_types = new();
-		internal readonly static Set<MethodInfo> cached_methods = new();
-		internal readonly static Set<FieldInfo> cached_fields = new();
-		internal readonly static Set<PropertyInfo> cached_properties = new();
-		internal readonly static Set<Attribute> cached_attributes = new();
-
-		private static Dictionary<Type, ManagedType> type_converters = new() {
-			{ typeof(sbyte), ManagedType.SByte },
-			{ typeof(byte), ManagedType.Byte },
-			{ typeof(short), ManagedType.Short },
-			{ typeof(ushort), ManagedType.UShort },
-			{ typeof(int), ManagedType.Int },
-			{ typeof(uint), ManagedType.UInt },
-			{ typeof(long), ManagedType.Long },
-			{ typeof(ulong), ManagedType.ULong },
-			{ typeof(float), ManagedType.Float },
-			{ typeof(double), ManagedType.Double },
-			{ typeof(bool), ManagedType.Bool },
-			{ typeof(NBool32), ManagedType.Bool },
-		};
+		/// partitioned by owning load context, unloading a context only drops the ids it owns
+		internal readonly static IdTable<Type> cached_types = new(AssemblyLoader.OwningContext);
+		internal readonly static IdTable<MethodInfo> cached_methods = new(AssemblyLoader.OwningContext);
+		internal readonly static IdTable<FieldInfo> cached_fields = new(AssemblyLoader.OwningContext);
+		internal readonly static IdTable<PropertyInfo> cached_properties = new(AssemblyLoader.OwningContext);
+		/// an attribute belongs with what it was read from, a shared attribute type on a plugin member goes with the plugin
+		internal readonly static IdTable<Attribute> cached_attributes = new();
+
+		internal static Int32 CacheAttribute(Attribute attr, ICustomAttributeProvider target) {
+			return cached_attributes.Add(attr, AssemblyLoader.OwningContext(target) ?? AssemblyLoader.OwningContext(attr.GetType()));
+		}
 
 		internal enum TypeAccessibility {
 			Public,
@@ -41,7 +33,7 @@ namespace DotOther.Managed {
 			PrivateProtected
 		}
 
-		private static TypeAccessibility GetTypeAccessibility(FieldInfo finfo) {
+		internal static TypeAccessibility GetTypeAccessibility(FieldInfo finfo) {
 			if (finfo.IsPublic) return TypeAccessibility.Public;
 			if (finfo.IsPrivate) return TypeAccessibility.Private;
 			if (finfo.IsFamily) return TypeAccessibility.Protected;
@@ -51,7 +43,7 @@ namespace DotOther.Managed {
 			return TypeAccessibility.Public;
 		}
 
-		private static TypeAccessibility GetTypeAccessibility(MethodInfo minfo) {
+		internal static TypeAccessibility GetTypeAccessibility(MethodInfo minfo) {
 			if (minfo.IsPublic) return TypeAccessibility.Public;
 			if (minfo.IsPrivate) return TypeAccessibility.Private;
 			if (minfo.IsFamily) return TypeAccessibility.Protected;
@@ -107,50 +99,24 @@ namespace DotOther.Managed {
 			return sb.ToString();
 		}
 
-		internal static unsafe T? FindSuitableMethod<T>(string? method_name, ManagedType* param_types, Int32 argc, ReadOnlySpan<T> methods) where T : MethodBase {
+		internal static T? FindSuitableMethod<T>(string? method_name, UInt64 signature, Int32 argc, ReadOnlySpan<T> methods) where T : MethodBase {
 			if (method_name == null) {
 				return null;
 			}
 
-			// LogMessage($"Finding suitable method '{method_name}' with {argc} arguments", MessageLevel.Trace);
 			foreach (var minfo in methods) {
-				// LogMessage($" > Checking method '{minfo}' ({minfo.GetParameters().Length})", MessageLevel.Trace);
-				ParameterInfo[] parameters = minfo.GetParameters();
-				if (parameters.Length != argc) {
-					continue;
-				}
-				// LogMessage($"	> Found method '{minfo}' with {parameters.Length} parameters", MessageLevel.Trace);
-				if (method_name == minfo.ToString()) {
-					// LogMessage($"	> Found exact match for method '{minfo}'", MessageLevel.Trace);
+				/// a fully spelled out signature (e.g. 'Void Foo(Int32)') names the overload directly
+				if (method_name == minfo.ToString() && minfo.GetParameters().Length == argc) {
 					return minfo;
 				}
 
 				if (minfo.Name != method_name) {
-					// LogMessage($"	!> Method '{minfo}' doesn't match the required name", MessageLevel.Trace);
 					continue;
 				}
 
-				// LogMessage($"	> Checking method '{minfo}' for parameter types", MessageLevel.Trace);
-				Int32 type_match = 0;
-				for (Int32 i = 0; i < parameters.Length; i++) {
-					ManagedType ptype;
-					if (parameters[i].ParameterType.IsPointer || parameters[i].ParameterType == typeof(IntPtr)) {
-						ptype = ManagedType.Pointer;
-					} else if (!type_converters.TryGetValue(parameters[i].ParameterType, out ptype)) {
-						ptype = ManagedType.Unknown;
-					}
-
-					// LogMessage($"		> Checking parameter {i} : {ptype} == {param_types[i]}", MessageLevel.Trace);
-					if (ptype == param_types[i]) {
-						type_match++;
-					}
-				}
-
-				if (type_match == argc) {
-					// LogMessage($"	> Found suitable method '{minfo}'", MessageLevel.Trace);
+				/// the signature hash already folds in the parameter count and kinds, see MethodSignature.cs
+				if (MethodSignature.Of(minfo) == signature) {
 					return minfo;
-				} else {
-					LogMessage($"Method '{minfo}' doesn't match the required types", MessageLevel.Trace);
 				}
 			}
 
@@ -161,7 +127,7 @@ namespace DotOther.Managed {
 
 #nullable disable
 		[UnmanagedCallersOnly]
-		private static unsafe void GetAsmTypes(Int32 asm_id, Int32* out_types, Int32* out_type_count) {
+		internal static unsafe void GetAsmTypes(Int32 asm_id, Int32* out_types, Int32* out_type_count) {
 			try {
 				if (!AssemblyLoader.TryGetAssembly(asm_id, out var asm)) {
 					LogMessage($"Couldn't get types for assembly '{asm_id}', assembly not found", MessageLevel.Error);
@@ -191,7 +157,7 @@ namespace DotOther.Managed {
 		}
 
 		[UnmanagedCallersOnly]
-		private static unsafe void GetNetCoreTypes(Int32* out_types, Int32* out_type_count) {
+		internal static unsafe void GetNetCoreTypes(Int32* out_types, Int32* out_type_count) {
 			try {
 				if (!AssemblyLoader.CoreAsmsLoaded) {
 					LogMessage("Couldn't get types for .NET Core assemblies, no assemblies loaded", MessageLevel.Error);
@@ -216,7 +182,7 @@ namespace DotOther.Managed {
 		}
 
 		[UnmanagedCallersOnly]
-		private static unsafe void GetTypeId(NString name, Int32* out_type) {
+		internal static unsafe void GetTypeId(NString name, Int32* out_type) {
 			try {
 				var type = FindType(name);
 				if (type == null) {
@@ -231,8 +197,90 @@ namespace DotOther.Managed {
 			}
 		}
 
+		/// closed generic types by definition and argument ids, MakeGenericType validates and allocates on every call
+		internal readonly struct GenericKey : IEquatable<GenericKey> {
+			internal readonly Int32 definition;
+			internal readonly Int32[] args;
+
+			internal GenericKey(Int32 definition, Int32[] args) {
+				this.definition = definition;
+				this.args = args;
+			}
+
+			public bool Equals(GenericKey other) {
+				return definition == other.definition && args.AsSpan().SequenceEqual(other.args);
+			}
+
+			public override bool Equals(object obj) => obj is GenericKey other && Equals(other);
+
+			public override Int32 GetHashCode() {
+				var hash = new HashCode();
+				hash.Add(definition);
+				foreach (var arg in args) {
+					hash.Add(arg);
+				}
+				return hash.ToHashCode();
+			}
+		}
+
+		internal static readonly ConcurrentDictionary<GenericKey, Int32> generic_types = new();
+
+		/// per-thread scratch keys for the lookup, indexed by argument count. Only a miss copies the arguments into a
+		///   key of its own
+		[ThreadStatic] private static Int32[][] generic_probes;
+
+		private static unsafe GenericKey ProbeKey(Int32 definition, Int32* args, Int32 argc) {
+			generic_probes ??= new Int32[8][];
+			Int32[] probe = argc < generic_probes.Length ? (generic_probes[argc] ??= new Int32[argc]) : new Int32[argc];
+			new ReadOnlySpan<Int32>(args, argc).CopyTo(probe);
+			return new GenericKey(definition, probe);
+		}
+
+		[UnmanagedCallersOnly]
+		internal static unsafe void MakeGenericType(Int32 definition, Int32* args, Int32 argc, Int32* out_type) {
+			try {
+				if (out_type == null) {
+					throw new ArgumentNullException(nameof(out_type));
+				}
+
+				*out_type = -1;
+
+				var probe = ProbeKey(definition, args, argc);
+				if (generic_types.TryGetValue(probe, out var cached)) {
+					*out_type = cached;
+					return;
+				}
+
+				if (!cached_types.TryGet(definition, out var generic_def) || generic_def == null || !generic_def.IsGenericTypeDefinition) {
+					LogMessage($"Couldn't instantiate type '{definition}', not a generic type definition", MessageLevel.Error);
+					return;
+				}
+
+				Int32 arity = generic_def.GetGenericArguments().Length;
+				if (arity != argc) {
+					LogMessage($"Couldn't instantiate '{generic_def.FullName}', expected {arity} type arguments, got {argc}", MessageLevel.Error);
+					return;
+				}
+
+				var arg_types = new Type[argc];
+				for (Int32 i = 0; i < argc; i++) {
+					if (!cached_types.TryGet(args[i], out var arg) || arg == null) {
+						LogMessage($"Couldn't instantiate '{generic_def.FullName}', argument {i} ('{args[i]}') not found", MessageLevel.Error);
+						return;
+					}
+					arg_types[i] = arg;
+				}
+
+				/// throws on constraint mismatches, HandleException reports it
+				var key = new GenericKey(definition, probe.args.AsSpan().ToArray());
+				*out_type = generic_types.GetOrAdd(key, cached_types.Add(generic_def.MakeGenericType(arg_types)));
+			} catch (Exception ex) {
+				HandleException(ex);
+			}
+		}
+
 		[UnmanagedCallersOnly]
-		private static unsafe NString GetAsmQualifiedName(Int32 type) {
+		internal static unsafe NString GetAsmQualifiedName(Int32 type) {
 			try {
 				if (!cached_types.TryGet(type, out var t)) {
 					return NString.Null();
@@ -246,7 +294,7 @@ namespace DotOther.Managed {
 		}
 
 		[UnmanagedCallersOnly]
-		private static unsafe NString GetFullTypeName(Int32 type_id) {
+		internal static unsafe NString GetFullTypeName(Int32 type_id) {
 			try {
 				if (!cached_types.TryGet(type_id, out var type)) {
 					return NString.Null();
@@ -261,7 +309,7 @@ namespace DotOther.Managed {
 		}
 
 		[UnmanagedCallersOnly]
-		private static unsafe void GetBaseType(Int32 in_type, Int32* out_base_type) {
+		internal static unsafe void GetBaseType(Int32 in_type, Int32* out_base_type) {
 			try {
 				if (!cached_types.TryGet(in_type, out var type) || out_base_type == null) {
 					return;
@@ -279,7 +327,7 @@ namespace DotOther.Managed {
 		}
 
 		[UnmanagedCallersOnly]
-		private static Int32 GetTypeSize(Int32 type) {
+		internal static Int32 GetTypeSize(Int32 type) {
 			try {
 				if (!cached_types.TryGet(type, out var t)) {
 					return 0;
@@ -293,7 +341,7 @@ namespace DotOther.Managed {
 		}
 
 		[UnmanagedCallersOnly]
-		private static unsafe NBool32 IsTypeDerivedFrom(Int32 t0, Int32 t1) {
+		internal static unsafe NBool32 IsTypeDerivedFrom(Int32 t0, Int32 t1) {
 			try {
 				if (!cached_types.TryGet(t0, out var type0) || !cached_types.TryGet(t1, out var type1)) {
 					return false;
@@ -307,7 +355,7 @@ namespace DotOther.Managed {
 		}
 
 		[UnmanagedCallersOnly]
-		private static unsafe NBool32 IsAssignableTo(Int32 t0, Int32 t1) {
+		internal static unsafe NBool32 IsAssignableTo(Int32 t0, Int32 t1) {
 			try {
 				if (!cached_types.TryGet(t0, out var type0) || !cached_types.TryGet(t1, out var type1)) {
 					return false;
@@ -321,7 +369,7 @@ namespace DotOther.Managed {
 		}
 
 		[UnmanagedCallersOnly]
-		private static unsafe NBool32 IsAssignableFrom(Int32 t0, Int32 t1) {
+		internal static unsafe NBool32 IsAssignableFrom(Int32 t0, Int32 t1) {
 			try {
 				if (!cached_types.TryGet(t0, out var type0) || !cached_types.TryGet(t1, out var type1)) {
 					return false;
@@ -335,7 +383,7 @@ namespace DotOther.Managed {
 		}
 
 		[UnmanagedCallersOnly]
-		private static unsafe NBool32 IsSzArray(Int32 type_id) {
+		internal static unsafe NBool32 IsSzArray(Int32 type_id) {
 			try {
 				if (!cached_types.TryGet(type_id, out var type)) {
 					return false;
@@ -349,7 +397,7 @@ namespace DotOther.Managed {
 		}
 
 		[UnmanagedCallersOnly]
-		private static unsafe void GetElementType(Int32 id, Int32* out_type) {
+		internal static unsafe void GetElementType(Int32 id, Int32* out_type) {
 			try {
 				if (!cached_types.TryGet(id, out var type)) {
 					return;
@@ -368,7 +416,7 @@ namespace DotOther.Managed {
 		}
 
 		[UnmanagedCallersOnly]
-		private static unsafe void GetTypeMethods(Int32 type, Int32* method_arr, Int32* count) {
+		internal static unsafe void GetTypeMethods(Int32 type, Int32* method_arr, Int32* count) {
 			try {
 				if (!cached_types.TryGet(type, out var t)) {
 					return;
@@ -398,7 +446,7 @@ namespace DotOther.Managed {
 		}
 
 		[UnmanagedCallersOnly]
-		private static unsafe void GetTypeFields(Int32 type, Int32* field_arr, Int32* field_count) {
+		internal static unsafe void GetTypeFields(Int32 type, Int32* field_arr, Int32* field_count) {
 			try {
 				if (field_count == null) {
 					throw new ArgumentNullException(nameof(field_count));
@@ -429,7 +477,7 @@ namespace DotOther.Managed {
 		}
 
 		[UnmanagedCallersOnly]
-		private static unsafe void GetTypeProperties(Int32 type, Int32* arr, Int32* count) {
+		internal static unsafe void GetTypeProperties(Int32 type, Int32* arr, Int32* count) {
 			try {
 				if (!cached_types.TryGet(type, out var t)) {
 					return;
@@ -456,13 +504,13 @@ namespace DotOther.Managed {
 		}
 
 		[UnmanagedCallersOnly]
-		private static unsafe NBool32 HasAttribute(Int32 type , Int32 attr_type) {
+		internal static unsafe NBool32 HasAttribute(Int32 type , Int32 attr_type) {
 			try {
-				if (!cached_types.TryGet(type, out var t) || !cached_attributes.TryGet(attr_type, out var attr)) {
+				if (!cached_types.TryGet(type, out var t) || !cached_types.TryGet(attr_type, out var attr)) {
 					return false;
 				}
 
-				return t.GetCustomAttribute(attr) != null;
+				return t.IsDefined(attr, true);
 			} catch (Exception ex) {
 				HandleException(ex);
 				return false;
@@ -470,7 +518,7 @@ namespace DotOther.Managed {
 		}
 
 		[UnmanagedCallersOnly]
-		private static unsafe void GetAttributes(Int32 type, Int32* attributes, Int32* count) {
+		internal static unsafe void GetAttributes(Int32 type, Int32* attributes, Int32* count) {
 			try {
 				if (!cached_types.TryGet(type, out var t)) {
 					return;
@@ -490,7 +538,7 @@ namespace DotOther.Managed {
 
 				for (Int32 i = 0; i < attrs.Length; i++) {
 					Attribute attr = (Attribute)attrs[i];
-					attributes[i] = cached_attributes.Add(attr);
+					attributes[i] = CacheAttribute(attr, t);
 				}
 			} catch (Exception ex) {
 				HandleException(ex);
@@ -498,17 +546,13 @@ namespace DotOther.Managed {
 		}
 
 		[UnmanagedCallersOnly]
-		private static unsafe ManagedType GetTypeManagedType(Int32 type) {
+		internal static unsafe ManagedType GetTypeManagedType(Int32 type) {
 			try {
-				if (!cached_types.TryGet(type, out var t)) {
+				if (!cached_types.TryGet(type, out var t) || t == null) {
 					return ManagedType.Unknown;
 				}
 
-				if (!type_converters.TryGetValue(t, out var mtype)) {
-					mtype = ManagedType.Unknown;
-				}
-
-				return mtype;
+				return MethodSignature.KindOf(t);
 			} catch (Exception ex) {
 				HandleException(ex);
 				return ManagedType.Unknown;
@@ -516,7 +560,7 @@ namespace DotOther.Managed {
 		}
 
 		[UnmanagedCallersOnly]
-		private static unsafe NString GetMethodName(Int32 method_info) {
+		internal static unsafe NString GetMethodName(Int32 method_info) {
 			try {
 				if (!cached_methods.TryGet(method_info, out var minfo)) {
 					return NString.Null();
@@ -530,7 +574,7 @@ namespace DotOther.Managed {
 		}
 
 		[UnmanagedCallersOnly]
-		private static unsafe void GetMethodReturnType(Int32 method_info, Int32* out_type) {
+		internal static unsafe void GetMethodReturnType(Int32 method_info, Int32* out_type) {
 			try {
 				if (!cached_methods.TryGet(method_info, out var minfo) || out_type == null)
 					return;
@@ -542,7 +586,7 @@ namespace DotOther.Managed {
 		}
 
 		[UnmanagedCallersOnly]
-		private static unsafe void GetMethodParameterTypes(Int32 minfo, Int32* out_param_types, Int32* count) {
+		internal static unsafe void GetMethodParameterTypes(Int32 minfo, Int32* out_param_types, Int32* count) {
 			try {
 				if (!cached_methods.TryGet(minfo, out var methodInfo)) {
 					return;
@@ -570,7 +614,7 @@ namespace DotOther.Managed {
 		}
 
 		[UnmanagedCallersOnly]
-		private static unsafe void GetMethodAttributes(Int32 minfo, Int32* out_attrs, Int32* count) {
+		internal static unsafe void GetMethodAttributes(Int32 minfo, Int32* out_attrs, Int32* count) {
 			try {
 				if (!cached_methods.TryGet(minfo, out var methodInfo)) {
 					*count = 0;
@@ -591,7 +635,7 @@ namespace DotOther.Managed {
 				}
 
 				for (Int32 i = 0; i < attributes.Length; i++) {
-					out_attrs[i] = cached_attributes.Add(attributes[i]);
+					out_attrs[i] = CacheAttribute(attributes[i], methodInfo);
 				}
 			} catch (Exception ex) {
 				HandleException(ex);
@@ -599,7 +643,7 @@ namespace DotOther.Managed {
 		} 
 
 		[UnmanagedCallersOnly]
-		private static unsafe TypeAccessibility GetMethodAccessibility(Int32 id) {
+		internal static unsafe TypeAccessibility GetMethodAccessibility(Int32 id) {
 			try {
 				if (!cached_methods.TryGet(id, out var minfo)) {
 					return TypeAccessibility.Internal;
@@ -613,7 +657,21 @@ namespace DotOther.Managed {
 		}
 
 		[UnmanagedCallersOnly]
-		private static unsafe NString GetFieldName(Int32 id, Int32* out_type) {
+		internal static UInt64 GetMethodSignature(Int32 id) {
+			try {
+				if (!cached_methods.TryGet(id, out var minfo) || minfo == null) {
+					return 0;
+				}
+
+				return MethodSignature.Of(minfo);
+			} catch (Exception ex) {
+				HandleException(ex);
+				return 0;
+			}
+		}
+
+		[UnmanagedCallersOnly]
+		internal static unsafe NString GetFieldName(Int32 id, Int32* out_type) {
 			try {
 				if (!cached_fields.TryGet(id, out var finfo)) {
 					return NString.Null();
@@ -627,7 +685,7 @@ namespace DotOther.Managed {
 		}
 
 		[UnmanagedCallersOnly]
-		private static unsafe void GetFieldType(Int32 id, Int32* out_type) {
+		internal static unsafe void GetFieldType(Int32 id, Int32* out_type) {
 			try {
 				if (!cached_fields.TryGet(id, out var finfo) || out_type == null) {
 					return;
@@ -640,7 +698,7 @@ namespace DotOther.Managed {
 		}
 
 		[UnmanagedCallersOnly]
-		private static unsafe TypeAccessibility GetFieldAccessibility(Int32 id) {
+		internal static unsafe TypeAccessibility GetFieldAccessibility(Int32 id) {
 			try {
 				if (!cached_fields.TryGet(id, out var finfo)) {
 					return TypeAccessibility.Internal;
@@ -654,7 +712,7 @@ namespace DotOther.Managed {
 		}
 
 		[UnmanagedCallersOnly]
-		private static unsafe void GetFieldAttributes(Int32 id, Int32* out_attrs, Int32* count) {
+		internal static unsafe void GetFieldAttributes(Int32 id, Int32* out_attrs, Int32* count) {
 			try {
 				if (!cached_fields.TryGet(id, out var finfo)) {
 					*count = 0;
@@ -675,7 +733,7 @@ namespace DotOther.Managed {
 				}
 
 				for (Int32 i = 0; i < attributes.Length; i++) {
-					out_attrs[i] = cached_attributes.Add((Attribute)attributes[i]);
+					out_attrs[i] = CacheAttribute((Attribute)attributes[i], finfo);
 				}
 			} catch (Exception ex) {
 				HandleException(ex);
@@ -683,7 +741,7 @@ namespace DotOther.Managed {
 		}
 
 		[UnmanagedCallersOnly]
-		private static unsafe NString GetPropertyName(Int32 id, Int32* out_type) {
+		internal static unsafe NString GetPropertyName(Int32 id, Int32* out_type) {
 			try {
 				if (!cached_properties.TryGet(id, out var pinfo)) {
 					return NString.Null();
@@ -697,7 +755,7 @@ namespace DotOther.Managed {
 		}
 
 		[UnmanagedCallersOnly]
-		private static unsafe void GetPropertyType(Int32 id, Int32* out_type) {
+		internal static unsafe void GetPropertyType(Int32 id, Int32* out_type) {
 			try {
 				if (!cached_properties.TryGet(id, out var pinfo) || out_type == null) {
 					return;
@@ -710,7 +768,7 @@ namespace DotOther.Managed {
 		}
 
 		[UnmanagedCallersOnly]
-		private static unsafe void GetPropertyAttributes(Int32 id, Int32* out_attrs, Int32* count) {
+		internal static unsafe void GetPropertyAttributes(Int32 id, Int32* out_attrs, Int32* count) {
 			try {
 				if (!cached_properties.TryGet(id, out var pinfo)) {
 					*count = 0;
@@ -731,7 +789,7 @@ namespace DotOther.Managed {
 				}
 
 				for (Int32 i = 0; i < attributes.Length; i++) {
-					out_attrs[i] = cached_attributes.Add(attributes[i]);
+					out_attrs[i] = CacheAttribute(attributes[i], pinfo);
 				}
 			} catch (Exception ex) {
 				HandleException(ex);
@@ -739,7 +797,7 @@ namespace DotOther.Managed {
 		}
 
 		[UnmanagedCallersOnly]
-		private static unsafe void GetAttributeValue(Int32 attr, NString name, IntPtr out_val) {
+		internal static unsafe void GetAttributeValue(Int32 attr, NString name, IntPtr out_val) {
 			try {
 				if (!cached_attributes.TryGet(attr, out var attribute)) {
 					return;
@@ -752,20 +810,42 @@ namespace DotOther.Managed {
 					return;
 				}
 
-				Interop.DotOtherMarshal.MarshalReturn(field.GetValue(attr), field.FieldType, out_val);
+				Interop.DotOtherMarshal.MarshalReturn(field.GetValue(attribute), field.FieldType, out_val);
+			} catch (Exception ex) {
+				HandleException(ex);
+			}
+		}
+
+		[UnmanagedCallersOnly]
+		internal static unsafe void GetAttributeSnapshot(Int32 attr, IntPtr* out_block, Int32* out_size) {
+			try {
+				if (out_block == null || out_size == null) {
+					throw new ArgumentNullException(out_block == null ? nameof(out_block) : nameof(out_size));
+				}
+
+				*out_block = IntPtr.Zero;
+				*out_size = 0;
+
+				if (!cached_attributes.TryGet(attr, out var attribute)) {
+					LogMessage($"Couldn't snapshot attribute '{attr}', attribute not found", MessageLevel.Error);
+					return;
+				}
+
+				*out_block = AttributeSnapshot.Build(attribute!, out var size);
+				*out_size = size;
 			} catch (Exception ex) {
 				HandleException(ex);
 			}
 		}
 
 		[UnmanagedCallersOnly]
-		private static unsafe void GetAttributeType(Int32 attr, Int32* out_type) {
+		internal static unsafe void GetAttributeType(Int32 attr, Int32* out_type) {
 			try { 
 				if (!cached_attributes.TryGet(attr, out var attribute)) {
 					return;
 				}
 
-				*out_type = cached_types.Add(attr.GetType());
+				*out_type = cached_types.Add(attribute!.GetType());
 			} catch (Exception e) {
 				HandleException(e);
 			}
@@ -1,8 +1,10 @@
 using System;
 using System.Collections.Generic;
 using System.Diagnostics.CodeAnalysis;
+using System.Linq;
 using System.Reflection;
 using System.Runtime.InteropServices;
+using System.Runtime.Loader;
 using System.Text;
 
 namespace DotOther.Managed {
@@ -26,60 +28,35 @@ namespace DotOther.Managed {
 
 		Bool,
 
-		Pointer
+		Pointer,
+
+		String,
+		Array,
+		Object,
+		Struct,
+		NativeObject
 	};
 
 #nullable enable
 	internal static class ManagedObject {
 
-		public readonly struct MethodKey : IEquatable<MethodKey> {
-			public readonly string type_name;
-			public readonly string name;
-			public readonly ManagedType[] arg_types;
-			public readonly Int32 param_count;
-
-			public MethodKey(string type_name, string name, ManagedType[] arg_types, Int32 param_count) {
-				this.type_name = type_name;
-				this.name = name;
-				this.arg_types = arg_types;
-				this.param_count = arg_types.Length;
-			}
-			public override bool Equals([NotNullWhen(true)] object? obj) => obj is MethodKey key && Equals(key);
+		public readonly record struct MethodKey(Type type, string name, UInt64 signature);
 
-			bool IEquatable<MethodKey>.Equals(MethodKey other) {
-				if (type_name != other.type_name || name != other.name || param_count != other.param_count) {
-					return false;
-				}
+		internal static Dictionary<MethodKey , MethodInfo> methods = new Dictionary<MethodKey, MethodInfo>();
 
-				for (Int32 i = 0; i < param_count; i++) {
-					if (arg_types[i] != other.arg_types[i]) {
-						return false;
-					}
+		/// drops the lookups of an unloading context, keyed by its types or resolved to its methods
+		internal static void ForgetContext(AssemblyLoadContext alc) {
+			foreach (var (key, minfo) in methods.ToArray()) {
+				if (AssemblyLoader.OwningContext(key.type) == alc || AssemblyLoader.OwningContext(minfo) == alc) {
+					methods.Remove(key);
 				}
-
-				return true;
-			}
-
-			public override int GetHashCode() {
-				return base.GetHashCode();
 			}
 		}
 
-		internal static Dictionary<MethodKey , MethodInfo> methods = new Dictionary<MethodKey, MethodInfo>();
-
-		private static unsafe MethodInfo? TryGetMethodInfo(Type type, string? name, ManagedType* types, Int32 count, BindingFlags flags) {
+		private static unsafe MethodInfo? TryGetMethodInfo(Type type, string? name, UInt64 signature, Int32 count, BindingFlags flags) {
 			MethodInfo? minfo = null;
 
-			ManagedType[]? param_types = new ManagedType[count];
-
-			unsafe {
-				fixed (ManagedType* param_types_ptr = param_types) {
-					ulong size = sizeof(ManagedType) * (ulong)count;
-					Buffer.MemoryCopy(types, param_types_ptr, size, size);
-				}
-			}
-
-			MethodKey mkey = new MethodKey(type.FullName!, name!, param_types, count);
+			MethodKey mkey = new MethodKey(type, name!, signature);
 
 			if (methods.TryGetValue(mkey, out minfo)) {
 				if (minfo != null) {
@@ -97,7 +74,7 @@ namespace DotOther.Managed {
 				baseType = baseType.BaseType;
 			}
 
-			minfo = InteropInterface.FindSuitableMethod<MethodInfo>(name, types, count, CollectionsMarshal.AsSpan(method_info_list));
+			minfo = InteropInterface.FindSuitableMethod<MethodInfo>(name, signature, count, CollectionsMarshal.AsSpan(method_info_list));
 			if (minfo != null) {
 				methods.Add(mkey, minfo!);
 				return minfo;
@@ -108,7 +85,7 @@ namespace DotOther.Managed {
 		}
 
 		[UnmanagedCallersOnly]
-		private static unsafe IntPtr CreateObject(Int32 typeid, NBool32 weak_ref, IntPtr parameters, ManagedType* param_types, Int32 count) {
+		internal static unsafe IntPtr CreateObject(Int32 typeid, NBool32 weak_ref, IntPtr parameters, UInt64 signature, Int32 count) {
 			try {
 				if (!InteropInterface.cached_types.TryGet(typeid, out var type)) {
 					LogMessage($"Type with ID '{typeid}' not found in cache.", MessageLevel.Error);
@@ -120,7 +97,7 @@ namespace DotOther.Managed {
 				}
 
 				ReadOnlySpan<ConstructorInfo> ctors = type.GetConstructors(BindingFlags.NonPublic | BindingFlags.Public | BindingFlags.Instance);
-				ConstructorInfo? ctor = InteropInterface.FindSuitableMethod(".ctor", param_types, count, ctors);
+				ConstructorInfo? ctor = InteropInterface.FindSuitableMethod(".ctor", signature, count, ctors);
 				if (ctor == null) {
 					LogMessage($"No suitable constructor found for type '{type.FullName}'.", MessageLevel.Error);
 					return IntPtr.Zero;
@@ -162,16 +139,28 @@ namespace DotOther.Managed {
 		}
 
 		[UnmanagedCallersOnly]
-		private static unsafe void DestroyObject(IntPtr handle) {
+		internal static unsafe void DestroyObject(IntPtr handle) {
+			try {
+				/// a handle its assembly context already freed on unload is not freed twice
+				if (!AssemblyLoader.ReleaseHandle(handle)) {
+					LogMessage($"Handle {handle:x} is not owned by any loaded assembly, it was already released", MessageLevel.Trace);
+				}
+			} catch (Exception e) {
+				HandleException(e);
+			}
+		}
+
+		[UnmanagedCallersOnly]
+		internal static void ReleaseNativeObject(UInt64 handle) {
 			try {
-				GCHandle.FromIntPtr(handle).Free();
+				DotOtherHost.ReleaseNativeObject(handle);
 			} catch (Exception e) {
 				HandleException(e);
 			}
 		}
 
 		[UnmanagedCallersOnly]
-		private static unsafe void InvokeMethod(IntPtr handle, NString method_name, IntPtr parameters, ManagedType* param_types, int count) {
+		internal static unsafe void InvokeMethod(IntPtr handle, NString method_name, IntPtr parameters, UInt64 signature, int count) {
 			try {
 				// LogMessage($"Attempting to invoke method '{method_name}' on object with handle '{handle}'.", MessageLevel.Trace);
 				if (method_name == null) {
@@ -186,7 +175,7 @@ namespace DotOther.Managed {
 				Type target_type = target.GetType();
 				// LogMessage($"	> InvokeMethod target object found, type : [{target_type.FullName}]", MessageLevel.Trace);
 
-				MethodInfo? minfo = TryGetMethodInfo(target_type, method_name, param_types, count, BindingFlags.Public | BindingFlags.NonPublic | BindingFlags.Instance);
+				MethodInfo? minfo = TryGetMethodInfo(target_type, method_name, signature, count, BindingFlags.Public | BindingFlags.NonPublic | BindingFlags.Instance);
 				if (minfo == null) {
 					throw new MissingMethodException($"Method '{target_type.FullName}.{method_name}[{count}]' not found.");
 				}
@@ -201,7 +190,7 @@ namespace DotOther.Managed {
 		}
 
 		[UnmanagedCallersOnly]
-		private static unsafe void InvokeMethodRet(IntPtr handle , NString name , IntPtr parameters, ManagedType* param_types, Int32 count, IntPtr res) {
+		internal static unsafe void InvokeMethodRet(IntPtr handle , NString name , IntPtr parameters, UInt64 signature, Int32 count, IntPtr res) {
 			try {
 				var target = GCHandle.FromIntPtr(handle).Target;
 
@@ -216,7 +205,7 @@ namespace DotOther.Managed {
 				}
 
 				var target_type = target.GetType();
-				var method_info = TryGetMethodInfo(target_type, name, param_types, count, BindingFlags.Public | BindingFlags.NonPublic | BindingFlags.Instance);
+				var method_info = TryGetMethodInfo(target_type, name, signature, count, BindingFlags.Public | BindingFlags.NonPublic | BindingFlags.Instance);
 				if (method_info == null) {
 					LogMessage($"Method  ['{target_type.Name}.{name}'] was not found", MessageLevel.Error);
 					return;
@@ -235,7 +224,7 @@ namespace DotOther.Managed {
 		}
 
 		[UnmanagedCallersOnly]
-		private static unsafe void InvokeStaticMethod(Int32 handle, NString name, IntPtr parameters, ManagedType* param_types, Int32 count) {
+		internal static unsafe void InvokeStaticMethod(Int32 handle, NString name, IntPtr parameters, UInt64 signature, Int32 count) {
 			try {
 				if (!InteropInterface.cached_types.TryGet(handle, out var type)) {
 					LogMessage($"Type with ID '{handle}' not found in cache.", MessageLevel.Error);
@@ -247,7 +236,7 @@ namespace DotOther.Managed {
 					return;
 				}
 
-				var method_info = TryGetMethodInfo(type, name, param_types, count, BindingFlags.Public | BindingFlags.NonPublic | BindingFlags.Static);
+				var method_info = TryGetMethodInfo(type, name, signature, count, BindingFlags.Public | BindingFlags.NonPublic | BindingFlags.Static);
 				if (method_info == null) {
 					LogMessage($"Method  ['{type.Name}.{name}'] was not found", MessageLevel.Error);
 					return;
@@ -261,7 +250,7 @@ namespace DotOther.Managed {
 		}
 
 		[UnmanagedCallersOnly]
-		private static unsafe void InvokeStaticMethodRet(Int32 handle, NString name , IntPtr parameters, ManagedType* param_types, Int32 count, IntPtr res) {
+		internal static unsafe void InvokeStaticMethodRet(Int32 handle, NString name , IntPtr parameters, UInt64 signature, Int32 count, IntPtr res) {
 			try {
 				if (!InteropInterface.cached_types.TryGet(handle, out var type)) {
 					LogMessage($"Type with ID '{handle}' not found in cache.", MessageLevel.Error);
@@ -273,7 +262,7 @@ namespace DotOther.Managed {
 					return;
 				}
 
-				var method_info = TryGetMethodInfo(type, name, param_types, count, BindingFlags.Public | BindingFlags.NonPublic | BindingFlags.Static);
+				var method_info = TryGetMethodInfo(type, name, signature, count, BindingFlags.Public | BindingFlags.NonPublic | BindingFlags.Static);
 				if (method_info == null) {
 					LogMessage($"Method  ['{type.Name}.{name}'] was not found", MessageLevel.Error);
 					return;
@@ -292,7 +281,7 @@ namespace DotOther.Managed {
 		}
 
 		[UnmanagedCallersOnly]
-		private static unsafe void SetField(IntPtr target , NString name, IntPtr value) {
+		internal static unsafe void SetField(IntPtr target , NString name, IntPtr value) {
 			try {
 				var obj = GCHandle.FromIntPtr(target).Target;
 				if (obj == null) {
@@ -315,7 +304,7 @@ namespace DotOther.Managed {
 		}
 
 		[UnmanagedCallersOnly]
-		private static unsafe void GetField(IntPtr target, NString name, IntPtr res) {
+		internal static unsafe void GetField(IntPtr target, NString name, IntPtr res) {
 			try {
 				var obj = GCHandle.FromIntPtr(target).Target;
 				if (obj == null) {
@@ -338,7 +327,7 @@ namespace DotOther.Managed {
 		}
 
 		[UnmanagedCallersOnly]
-		private static unsafe void SetProperty(IntPtr target, NString name, IntPtr value) {
+		internal static unsafe void SetProperty(IntPtr target, NString name, IntPtr value) {
 			try {
 				var obj = GCHandle.FromIntPtr(target).Target;
 				if (obj == null) {
@@ -361,7 +350,7 @@ namespace DotOther.Managed {
 		}
 
 		[UnmanagedCallersOnly]
-		private static unsafe void GetProperty(IntPtr target, NString name, IntPtr res) {
+		internal static unsafe void GetProperty(IntPtr target, NString name, IntPtr res) {
 			try {
 				var obj = GCHandle.FromIntPtr(target).Target;
 				if (obj == null) {
@@ -1,6 +1,8 @@
 using System;
+using System.Collections.Concurrent;
 using System.Linq;
 using System.Reflection;
+using System.Runtime.CompilerServices;
 using System.Runtime.InteropServices;
 
 using DotOther.Managed;
@@ -8,9 +10,12 @@ using DotOther.Managed;
 namespace DotOther.Managed.Interop {
 
   public static class DotOtherMarshal {
+    /// untyped header of NArray, see NativeTypes.cs and hosting/native_array.hpp
+    [StructLayout(LayoutKind.Sequential, Pack = 1)]
     struct ArrayContainer {
       public IntPtr Data;
       public Int32 Length;
+      public NBool32 Owner;
     }
 
 #nullable enable
@@ -28,6 +33,11 @@ namespace DotOther.Managed.Interop {
         Marshal.StructureToPtr(nstring, result, false);
       } else if (val is NString nstring) {
         Marshal.StructureToPtr(nstring, result, false);
+      } else if (typeof(NObject).IsAssignableFrom(type)) {
+        /// native resolves the handle against its registered objects, the object itself never crosses
+        Marshal.WriteInt64(result, (Int64)((val as NObject)?.NHandle ?? 0));
+      } else if (!type.IsValueType && !type.IsPointer) {
+        Marshal.WriteIntPtr(result, val == null ? IntPtr.Zero : AllocReturnHandle(val));
       } else if (type.IsPointer) {
         unsafe {
           if (val == null) {
@@ -36,6 +46,8 @@ namespace DotOther.Managed.Interop {
             Marshal.WriteIntPtr(result, (IntPtr)val);
           }
         }
+      } else if (val != null && type.IsValueType && GetBlittableOps(type) is BlittableOps ops) {
+        ops.Store(val, result);
       } else {
         var val_size = Marshal.SizeOf(type);
         var handle = GCHandle.Alloc(val, GCHandleType.Pinned);
@@ -48,18 +60,94 @@ namespace DotOther.Managed.Interop {
       }
     }
 
+    /// returned managed objects are handed to native as a fresh GCHandle, registered with the object's assembly
+    ///   the same way CreateObject does. The receiving HostedObject frees it through DestroyObject, unloading the
+    ///   assembly context frees whatever native still holds.
+    private static IntPtr AllocReturnHandle(object val) {
+      var handle = GCHandle.Alloc(val, GCHandleType.Normal);
+      AssemblyLoader.RegisterHandle(val.GetType().Assembly, handle);
+      return GCHandle.ToIntPtr(handle);
+    }
+
+    /// one element of an object array, laid out as a native HostedObject { handle, Type* }
     struct ArrayObject {
       public IntPtr handle;
-      public Int32 padding;
+      public IntPtr type;
 
       public ArrayObject() {
         this.handle = IntPtr.Zero;
-        this.padding = 0;
+        this.type = IntPtr.Zero;
       }
 
       public ArrayObject(IntPtr handle) {
         this.handle = handle;
-        this.padding = 0;
+        this.type = IntPtr.Zero;
+      }
+    }
+
+    /// Copy routines for value types that contain no managed references, built once per type. Covers both arrays
+    ///   and single values passed by value (see DOTOTHER_MANAGED_STRUCT), so each crossing is one typed copy.
+    ///   Anything not covered here (reference types, structs holding references) goes through Marshal.
+    sealed record BlittableOps(Int32 ElementSize, Func<IntPtr, Int32, Array> Read, Action<Array, IntPtr> Write, Func<IntPtr, Int32, object> View,
+                               Func<IntPtr, object> Box, Action<object, IntPtr> Store);
+
+    /// weakly keyed, the ops of a type from a collectible context go away with it
+    private static readonly ConditionalWeakTable<Type, BlittableOps?> blittable_ops = new();
+
+    private static readonly MethodInfo contains_references_method = typeof(DotOtherMarshal).GetMethod(nameof(ContainsReferences), BindingFlags.NonPublic | BindingFlags.Static)!;
+    private static readonly MethodInfo create_ops_method = typeof(DotOtherMarshal).GetMethod(nameof(CreateBlittableOps), BindingFlags.NonPublic | BindingFlags.Static)!;
+
+    private static bool ContainsReferences<T>() => RuntimeHelpers.IsReferenceOrContainsReferences<T>();
+
+    private static BlittableOps CreateBlittableOps<T>() where T : unmanaged {
+      return new BlittableOps(Unsafe.SizeOf<T>(), ReadBlittableArray<T>, WriteBlittableArray<T>, ViewBlittableArray<T>,
+                              BoxBlittable<T>, StoreBlittable<T>);
+    }
+
+    private static unsafe object BoxBlittable<T>(IntPtr data) where T : unmanaged => *(T*)data.ToPointer();
+
+    private static unsafe void StoreBlittable<T>(object val, IntPtr dest) where T : unmanaged => *(T*)dest.ToPointer() = (T)val;
+
+    private static unsafe Array ReadBlittableArray<T>(IntPtr data, Int32 length) where T : unmanaged {
+      T[] res = GC.AllocateUninitializedArray<T>(length);
+      if (length > 0) {
+        new ReadOnlySpan<T>(data.ToPointer(), length).CopyTo(res);
+      }
+      return res;
+    }
+
+    private static unsafe void WriteBlittableArray<T>(Array arr, IntPtr data) where T : unmanaged {
+      var src = (T[])arr;
+      src.AsSpan().CopyTo(new Span<T>(data.ToPointer(), src.Length));
+    }
+
+    private static object ViewBlittableArray<T>(IntPtr data, Int32 length) where T : unmanaged => new NArray<T>(data, length);
+
+    private static BlittableOps? GetBlittableOps(Type elt_type) {
+      return blittable_ops.GetValue(elt_type, static t => {
+        if (!t.IsValueType || t.ContainsGenericParameters || Nullable.GetUnderlyingType(t) != null) {
+          return null;
+        }
+
+        if ((bool)contains_references_method.MakeGenericMethod(t).Invoke(null, null)!) {
+          return null;
+        }
+
+        return (BlittableOps)create_ops_method.MakeGenericMethod(t).Invoke(null, null)!;
+      });
+    }
+
+    /// Size of a value type as native code lays it out, 0 if it can not cross the boundary by value
+    internal static Int32 NativeSizeOf(Type type) {
+      var ops = GetBlittableOps(type);
+      if (ops != null) {
+        return ops.ElementSize;
+      }
+
+      try {
+        return Marshal.SizeOf(type);
+      } catch (ArgumentException) {
+        return 0;
       }
     }
 
@@ -69,6 +157,12 @@ namespace DotOther.Managed.Interop {
       }
 
       var arr_cont = MarshalPointer<ArrayContainer>(arr);
+
+      var ops = GetBlittableOps(elt_type);
+      if (ops != null) {
+        return ops.Read(arr_cont.Data, arr_cont.Length);
+      }
+
       var elts = Array.CreateInstance(elt_type, arr_cont.Length);
 
       if (elt_type.IsValueType) {
@@ -81,53 +175,72 @@ namespace DotOther.Managed.Interop {
           }
         }
       } else {
-        for (int i = 0; i < arr_cont.Length; i++) {
-          unsafe {
-            IntPtr src = (IntPtr)(((byte*)arr_cont.Data.ToPointer()) + (i * Marshal.SizeOf<ArrayObject>()));
-            var managed_obj = MarshalPointer<ArrayObject>(src);
-            var target = GCHandle.FromIntPtr(managed_obj.handle).Target;
-            elts.SetValue(target, i);
+        unsafe {
+          var handles = new ReadOnlySpan<ArrayObject>(arr_cont.Data.ToPointer(), arr_cont.Length);
+          for (int i = 0; i < handles.Length; i++) {
+            elts.SetValue(GCHandle.FromIntPtr(handles[i].handle).Target, i);
           }
         }
       }
 
       return elts;
     }
+
+    /// Wraps native array memory in an NArray view without copying, for callees that only need a span over the elements
+    public static object? MarshalArrayView(IntPtr arr, Type? elt_type) {
+      if (elt_type == null) {
+        return null;
+      }
+
+      var ops = GetBlittableOps(elt_type);
+      if (ops == null) {
+        throw new NotSupportedException($"Cannot create a view over native memory for non-blittable element type '{elt_type.FullName}'");
+      }
+
+      var arr_cont = MarshalPointer<ArrayContainer>(arr);
+      return ops.View(arr_cont.Data, arr_cont.Length);
+    }
     
     public static void CopyArrayToBuffer(IntPtr dest, Array? arr, Type? elt_type) {
       if (arr == null || elt_type == null) {
         return;
       }
 
-      var elt_size = Marshal.SizeOf(elt_type);
-      int blen = arr.Length * elt_size;
-      var mem = Marshal.AllocHGlobal(blen);
+      IntPtr mem = IntPtr.Zero;
 
-      Int32 offset = 0;
+      var ops = GetBlittableOps(elt_type);
+      if (ops != null) {
+        mem = Marshal.AllocHGlobal(Math.Max(arr.Length * ops.ElementSize, 1));
+        ops.Write(arr, mem);
+      } else if (elt_type.IsValueType) {
+        var elt_size = Marshal.SizeOf(elt_type);
+        mem = Marshal.AllocHGlobal(Math.Max(arr.Length * elt_size, 1));
 
-      foreach (var e in arr) {
-        var elt_handle = GCHandle.Alloc(mem, GCHandleType.Pinned);
+        for (int i = 0; i < arr.Length; i++) {
+          Marshal.StructureToPtr(arr.GetValue(i)!, IntPtr.Add(mem, i * elt_size), false);
+        }
+      } else {
+        mem = Marshal.AllocHGlobal(Math.Max(arr.Length * Marshal.SizeOf<ArrayObject>(), 1));
 
+        /// each element is a registered handle like any other returned object, the receiving NArray<HostedObject>
+        ///   frees them when it is destroyed
         unsafe {
-          Buffer.MemoryCopy(elt_handle.AddrOfPinnedObject().ToPointer(), (((byte*)mem.ToPointer()) + offset), elt_size, elt_size);
+          var handles = new Span<ArrayObject>(mem.ToPointer(), arr.Length);
+          for (int i = 0; i < handles.Length; i++) {
+            var elt = arr.GetValue(i);
+            handles[i] = elt == null ? new ArrayObject() : new ArrayObject(AllocReturnHandle(elt));
+          }
         }
-
-        offset += elt_size;
-        elt_handle.Free();
       }
 
-      ArrayContainer c = new ArrayContainer {
-        Data = mem,
-        Length = arr.Length
-      };
-
-      var handle = GCHandle.Alloc(c, GCHandleType.Pinned);
-
       unsafe {
-        Buffer.MemoryCopy(handle.AddrOfPinnedObject().ToPointer(), dest.ToPointer(), Marshal.SizeOf<ArrayContainer>(), Marshal.SizeOf<ArrayContainer>());
+        /// the receiving side owns the buffer from here on
+        *(ArrayContainer*)dest.ToPointer() = new ArrayContainer {
+          Data = mem,
+          Length = arr.Length,
+          Owner = true
+        };
       }
-
-      handle.Free();
     }
 
     public static object? MarshalPointer(IntPtr ptr, Type type) {
@@ -152,20 +265,23 @@ namespace DotOther.Managed.Interop {
         return MarshalArray(ptr, type.GetElementType());
       }
 
-      if (type.IsGenericType) {
-        if (type == typeof(NArray<>).MakeGenericType(type.GetGenericArguments().First())) {
-          var elts = Marshal.ReadIntPtr(ptr, 0);
-          var elt_count = Marshal.ReadInt32(ptr, Marshal.SizeOf<IntPtr>());
-          var gen_type = typeof(NArray<>).MakeGenericType(type.GetGenericArguments().First());
-          throw new Exception("Not implemented");
-          // return TypeInterface.CreateInstance(gen_type, elts, elt_count);
-        }
+      if (type.IsGenericType && type.GetGenericTypeDefinition() == typeof(NArray<>)) {
+        return MarshalArrayView(ptr, type.GetGenericArguments().First());
+      }
+
+      /// objects arrive as the handle value itself rather than a pointer to it, see util::ToArgSlot
+      if (typeof(NObject).IsAssignableFrom(type)) {
+        return DotOtherHost.GetNativeObject((UInt64)ptr.ToInt64(), type);
+      }
+
+      if (type.IsClass || type.IsInterface) {
+        return ptr == IntPtr.Zero ? null : GCHandle.FromIntPtr(ptr).Target;
       }
 
-      if (type.IsClass) {
-        var handle_ptr = Marshal.ReadIntPtr(ptr);
-        var handle = GCHandle.FromIntPtr(handle_ptr);
-        return handle.Target;
+      /// by-value structs and primitives, native passes the address of its own copy so this is the only copy made
+      var ops = GetBlittableOps(type);
+      if (ops != null) {
+        return ops.Box(ptr);
       }
 
       return Marshal.PtrToStructure(ptr, type);
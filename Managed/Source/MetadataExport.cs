@@ -0,0 +1,811 @@
+using System;
+using System.Collections.Generic;
+using System.Reflection;
+using System.Runtime.InteropServices;
+using System.Text;
+
+using DotOther.Managed.Interop;
+
+namespace DotOther.Managed {
+
+  using static DotOtherHost;
+
+  /// Flat metadata image of one assembly, mirrored by hosting/metadata_image.hpp.
+  ///
+  /// Layout: a Header followed by packed record arrays, each located by a Section. Strings are UTF-8, stored once in
+  ///   the string table as { UInt32 length, bytes } and referenced by offset. Types reference each other through
+  ///   a TypeRef: an index into the image's own type records, or, with the high bit set, an index into the
+  ///   external type records for types defined in other assemblies.
+  ///
+  /// Native may cache the image on disk, ids are only valid for the process that produced them. BindAssemblyMetadata
+  ///   resolves the type records of a cached image through their metadata tokens and returns the ids of this process
+  ///   in record order, BindTypeMembers does the same for the members of one type when native first needs them.
+  internal static class MetadataExport {
+    internal const UInt32 kMagic = 0x444D4F44; // 'DOMD'
+    internal const UInt32 kVersion = 4;
+
+    internal const UInt32 kNoType = 0xFFFFFFFF;
+    internal const UInt32 kExternalType = 0x80000000;
+
+    [Flags]
+    internal enum TypeFlags : UInt32 {
+      None = 0,
+      SZArray = 1 << 0,
+      ValueType = 1 << 1,
+      Enum = 1 << 2,
+      Interface = 1 << 3,
+      Abstract = 1 << 4,
+      Generic = 1 << 5,
+    }
+
+    [StructLayout(LayoutKind.Sequential, Pack = 1)]
+    internal struct CacheKey {
+      public Guid Mvid;
+      public Int32 RuntimeMajor;
+      public Int32 RuntimeMinor;
+      public Int32 RuntimeBuild;
+    }
+
+    [StructLayout(LayoutKind.Sequential, Pack = 1)]
+    internal struct Section {
+      public UInt32 Offset;
+      public UInt32 Count;
+    }
+
+    [StructLayout(LayoutKind.Sequential, Pack = 1)]
+    internal struct Range {
+      public UInt32 First;
+      public UInt32 Count;
+    }
+
+    [StructLayout(LayoutKind.Sequential, Pack = 1)]
+    internal struct Header {
+      public UInt32 Magic;
+      public UInt32 Version;
+      public UInt32 Size;
+      public Int32 AsmId;
+      public UInt32 AsmName;
+      public CacheKey Key;
+      public Section Types;
+      public Section Externals;
+      public Section Methods;
+      public Section Fields;
+      public Section Properties;
+      public Section Attributes;
+      public Section TypeRefs;
+      public Section Strings;
+    }
+
+    [StructLayout(LayoutKind.Sequential, Pack = 1)]
+    internal struct TypeRecord {
+      public Int32 Id;
+      public Int32 Token;
+      public UInt32 Name;
+      public UInt32 FullName;
+      public UInt32 Namespace;
+      public UInt32 BaseType;
+      public UInt32 ElementType;
+      public Int32 Size;
+      public Int32 ManagedType;
+      public UInt32 Flags;
+      public Range Methods;
+      public Range Fields;
+      public Range Properties;
+      public Range Attributes;
+      public Range Ancestors;
+      public Range Interfaces;
+    }
+
+    [StructLayout(LayoutKind.Sequential, Pack = 1)]
+    internal struct ExternalTypeRecord {
+      public Int32 Id;
+      public UInt32 FullName;
+      public UInt32 AsmQualifiedName;
+    }
+
+    [StructLayout(LayoutKind.Sequential, Pack = 1)]
+    internal struct MethodRecord {
+      public Int32 Id;
+      public Int32 Token;
+      public UInt32 DeclaringType;
+      public UInt32 Name;
+      public UInt32 ReturnType;
+      public Range Params;
+      public Int32 Accessibility;
+      public UInt32 IsStatic;
+      public UInt64 Signature;
+      public Range Attributes;
+    }
+
+    [StructLayout(LayoutKind.Sequential, Pack = 1)]
+    internal struct FieldRecord {
+      public Int32 Id;
+      public Int32 Token;
+      public UInt32 DeclaringType;
+      public UInt32 Name;
+      public UInt32 Type;
+      public Int32 Accessibility;
+      public UInt32 IsStatic;
+      public Range Attributes;
+    }
+
+    [StructLayout(LayoutKind.Sequential, Pack = 1)]
+    internal struct PropertyRecord {
+      public Int32 Id;
+      public Int32 Token;
+      public UInt32 DeclaringType;
+      public UInt32 Name;
+      public UInt32 Type;
+    }
+
+    [StructLayout(LayoutKind.Sequential, Pack = 1)]
+    internal struct AttributeRecord {
+      public Int32 Id;
+      public UInt32 Type;
+    }
+
+    private const BindingFlags kMemberFlags = BindingFlags.Public | BindingFlags.NonPublic | BindingFlags.Instance | BindingFlags.Static;
+
+#nullable enable
+    private sealed class ImageBuilder {
+      internal readonly List<TypeRecord> types = new();
+      internal readonly List<ExternalTypeRecord> externals = new();
+      internal readonly List<MethodRecord> methods = new();
+      internal readonly List<FieldRecord> fields = new();
+      internal readonly List<PropertyRecord> properties = new();
+      internal readonly List<AttributeRecord> attributes = new();
+      internal readonly List<UInt32> type_refs = new();
+      internal readonly List<byte> strings = new();
+
+      private readonly Dictionary<Type, UInt32> local_types = new();
+      private readonly Dictionary<Type, UInt32> external_types = new();
+      private readonly Dictionary<string, UInt32> string_offsets = new();
+
+      internal ImageBuilder(ReadOnlySpan<Type> asm_types) {
+        /// offset 0 is always the empty string
+        Intern(string.Empty);
+
+        for (Int32 i = 0; i < asm_types.Length; i++) {
+          local_types[asm_types[i]] = (UInt32)i;
+        }
+      }
+
+      internal UInt32 Intern(string? str) {
+        str ??= string.Empty;
+        if (string_offsets.TryGetValue(str, out var offset)) {
+          return offset;
+        }
+
+        offset = (UInt32)strings.Count;
+        byte[] bytes = Encoding.UTF8.GetBytes(str);
+        strings.AddRange(BitConverter.GetBytes((UInt32)bytes.Length));
+        strings.AddRange(bytes);
+
+        string_offsets[str] = offset;
+        return offset;
+      }
+
+      internal UInt32 Ref(Type? type) {
+        if (type == null) {
+          return kNoType;
+        }
+
+        if (local_types.TryGetValue(type, out var index)) {
+          return index;
+        }
+
+        if (!external_types.TryGetValue(type, out index)) {
+          index = (UInt32)externals.Count;
+          externals.Add(new ExternalTypeRecord {
+            Id = InteropInterface.cached_types.Add(type),
+            FullName = Intern(type.FullName ?? type.Name),
+            AsmQualifiedName = Intern(type.AssemblyQualifiedName),
+          });
+          external_types[type] = index;
+        }
+
+        return index | kExternalType;
+      }
+    }
+
+    private static TypeFlags GetTypeFlags(Type type) {
+      TypeFlags flags = TypeFlags.None;
+      if (type.IsSZArray) flags |= TypeFlags.SZArray;
+      if (type.IsValueType) flags |= TypeFlags.ValueType;
+      if (type.IsEnum) flags |= TypeFlags.Enum;
+      if (type.IsInterface) flags |= TypeFlags.Interface;
+      if (type.IsAbstract) flags |= TypeFlags.Abstract;
+      if (type.IsGenericType) flags |= TypeFlags.Generic;
+      return flags;
+    }
+
+    private static Range AddMethods(ImageBuilder image, Type type) {
+      var range = new Range { First = (UInt32)image.methods.Count };
+      foreach (var minfo in type.GetMethods(kMemberFlags)) {
+        var parameters = minfo.GetParameters();
+        var param_range = new Range { First = (UInt32)image.type_refs.Count, Count = (UInt32)parameters.Length };
+        foreach (var param in parameters) {
+          image.type_refs.Add(image.Ref(param.ParameterType));
+        }
+
+        image.methods.Add(new MethodRecord {
+          Id = InteropInterface.cached_methods.Add(minfo),
+          Token = minfo.MetadataToken,
+          DeclaringType = image.Ref(minfo.DeclaringType),
+          Name = image.Intern(minfo.Name),
+          ReturnType = image.Ref(minfo.ReturnType),
+          Params = param_range,
+          Accessibility = (Int32)InteropInterface.GetTypeAccessibility(minfo),
+          IsStatic = minfo.IsStatic ? 1u : 0u,
+          Signature = MethodSignature.Of(minfo),
+          Attributes = AddAttributes(image, minfo),
+        });
+      }
+
+      range.Count = (UInt32)image.methods.Count - range.First;
+      return range;
+    }
+
+    private static Range AddFields(ImageBuilder image, Type type) {
+      var range = new Range { First = (UInt32)image.fields.Count };
+      foreach (var finfo in type.GetFields(kMemberFlags)) {
+        image.fields.Add(new FieldRecord {
+          Id = InteropInterface.cached_fields.Add(finfo),
+          Token = finfo.MetadataToken,
+          DeclaringType = image.Ref(finfo.DeclaringType),
+          Name = image.Intern(finfo.Name),
+          Type = image.Ref(finfo.FieldType),
+          Accessibility = (Int32)InteropInterface.GetTypeAccessibility(finfo),
+          IsStatic = finfo.IsStatic ? 1u : 0u,
+          Attributes = AddAttributes(image, finfo),
+        });
+      }
+
+      range.Count = (UInt32)image.fields.Count - range.First;
+      return range;
+    }
+
+    private static Range AddProperties(ImageBuilder image, Type type) {
+      var range = new Range { First = (UInt32)image.properties.Count };
+      foreach (var pinfo in type.GetProperties(kMemberFlags)) {
+        image.properties.Add(new PropertyRecord {
+          Id = InteropInterface.cached_properties.Add(pinfo),
+          Token = pinfo.MetadataToken,
+          DeclaringType = image.Ref(pinfo.DeclaringType),
+          Name = image.Intern(pinfo.Name),
+          Type = image.Ref(pinfo.PropertyType),
+        });
+      }
+
+      range.Count = (UInt32)image.properties.Count - range.First;
+      return range;
+    }
+
+    /// types, methods and fields all record their attributes, native indexes them per attribute type
+    private static Range AddAttributes(ImageBuilder image, MemberInfo member) {
+      var range = new Range { First = (UInt32)image.attributes.Count };
+
+      object[] attrs;
+      try {
+        attrs = member.GetCustomAttributes(true);
+      } catch (Exception e) {
+        /// an attribute type that fails to resolve should not take the rest of the image down with it
+        LogMessage($"Skipping attributes of '{member.DeclaringType?.FullName}.{member.Name}': {e.Message}", MessageLevel.Warning);
+        return range;
+      }
+
+      foreach (Attribute attr in attrs) {
+        image.attributes.Add(new AttributeRecord {
+          Id = InteropInterface.CacheAttribute(attr, member),
+          Type = image.Ref(attr.GetType()),
+        });
+      }
+
+      range.Count = (UInt32)image.attributes.Count - range.First;
+      return range;
+    }
+
+    /// base type chain root first, native appends the type itself to form its ancestor display
+    private static Range AddAncestors(ImageBuilder image, Type type) {
+      var chain = new List<Type>();
+      for (Type? base_type = type.BaseType; base_type != null; base_type = base_type.BaseType) {
+        chain.Add(base_type);
+      }
+      chain.Reverse();
+
+      var range = new Range { First = (UInt32)image.type_refs.Count, Count = (UInt32)chain.Count };
+      foreach (var ancestor in chain) {
+        image.type_refs.Add(image.Ref(ancestor));
+      }
+
+      return range;
+    }
+
+    private static Range AddInterfaces(ImageBuilder image, Type type) {
+      var interfaces = type.GetInterfaces();
+
+      var range = new Range { First = (UInt32)image.type_refs.Count, Count = (UInt32)interfaces.Length };
+      foreach (var iface in interfaces) {
+        image.type_refs.Add(image.Ref(iface));
+      }
+
+      return range;
+    }
+
+    private static UInt32 Align(UInt32 offset) => (offset + 7u) & ~7u;
+
+    private static unsafe Section WriteSection<T>(byte* dest, ref UInt32 offset, List<T> records) where T : unmanaged {
+      offset = Align(offset);
+      var section = new Section { Offset = offset, Count = (UInt32)records.Count };
+
+      var src = CollectionsMarshal.AsSpan(records);
+      src.CopyTo(new Span<T>(dest + offset, src.Length));
+      offset += (UInt32)(src.Length * sizeof(T));
+
+      return section;
+    }
+
+    private static ImageBuilder Walk(Assembly asm) {
+      ReadOnlySpan<Type> asm_types = asm.GetTypes();
+      var image = new ImageBuilder(asm_types);
+
+      foreach (var type in asm_types) {
+        var record = new TypeRecord {
+          Id = InteropInterface.cached_types.Add(type),
+          Token = type.MetadataToken,
+          Name = image.Intern(type.Name),
+          FullName = image.Intern(type.FullName ?? type.Name),
+          Namespace = image.Intern(type.Namespace),
+          BaseType = image.Ref(type.BaseType),
+          ElementType = image.Ref(type.HasElementType ? type.GetElementType() : null),
+          Size = type.IsValueType && !type.ContainsGenericParameters ? DotOtherMarshal.NativeSizeOf(type) : 0,
+          ManagedType = (Int32)MethodSignature.KindOf(type),
+          Flags = (UInt32)GetTypeFlags(type),
+        };
+
+        record.Methods = AddMethods(image, type);
+        record.Fields = AddFields(image, type);
+        record.Properties = AddProperties(image, type);
+        record.Attributes = AddAttributes(image, type);
+        record.Ancestors = AddAncestors(image, type);
+        record.Interfaces = AddInterfaces(image, type);
+        image.types.Add(record);
+      }
+
+      return image;
+    }
+
+    /// builds the image into HGlobal memory owned by the caller
+    internal static unsafe IntPtr Build(Int32 asm_id, Assembly asm, out Int32 size) {
+      var image = Walk(asm);
+
+      UInt32 asm_name = image.Intern(asm.GetName().Name);
+
+      UInt32 total = Align((UInt32)sizeof(Header));
+      total = Align(total + (UInt32)(image.types.Count * sizeof(TypeRecord)));
+      total = Align(total + (UInt32)(image.externals.Count * sizeof(ExternalTypeRecord)));
+      total = Align(total + (UInt32)(image.methods.Count * sizeof(MethodRecord)));
+      total = Align(total + (UInt32)(image.fields.Count * sizeof(FieldRecord)));
+      total = Align(total + (UInt32)(image.properties.Count * sizeof(PropertyRecord)));
+      total = Align(total + (UInt32)(image.attributes.Count * sizeof(AttributeRecord)));
+      total = Align(total + (UInt32)(image.type_refs.Count * sizeof(UInt32)));
+      total = Align(total + (UInt32)image.strings.Count);
+
+      IntPtr mem = Marshal.AllocHGlobal((Int32)total);
+      byte* dest = (byte*)mem.ToPointer();
+      new Span<byte>(dest, (Int32)total).Clear();
+
+      UInt32 offset = (UInt32)sizeof(Header);
+      Header header = new Header {
+        Magic = kMagic,
+        Version = kVersion,
+        Size = total,
+        AsmId = asm_id,
+        AsmName = asm_name,
+        Key = KeyOf(asm),
+      };
+
+      header.Types = WriteSection(dest, ref offset, image.types);
+      header.Externals = WriteSection(dest, ref offset, image.externals);
+      header.Methods = WriteSection(dest, ref offset, image.methods);
+      header.Fields = WriteSection(dest, ref offset, image.fields);
+      header.Properties = WriteSection(dest, ref offset, image.properties);
+      header.Attributes = WriteSection(dest, ref offset, image.attributes);
+      header.TypeRefs = WriteSection(dest, ref offset, image.type_refs);
+      header.Strings = WriteSection(dest, ref offset, image.strings);
+
+      *(Header*)dest = header;
+
+      size = (Int32)total;
+      return mem;
+    }
+
+    /// the module version id changes with every build of the assembly, the runtime version decides what reflection
+    ///   hands back for it, an image is only reused when both match
+    private static CacheKey KeyOf(Assembly asm) {
+      Version runtime = Environment.Version;
+      return new CacheKey {
+        Mvid = asm.ManifestModule.ModuleVersionId,
+        RuntimeMajor = runtime.Major,
+        RuntimeMinor = runtime.Minor,
+        RuntimeBuild = runtime.Build,
+      };
+    }
+
+    /// Resolves the records of a cached image against the loaded assembly through their metadata tokens. Types resolve
+    ///   in the assembly's module, members in the module of their declaring type and are then reflected through the
+    ///   type that listed them, exactly as GetMethods and friends returned them to Build. The types and the types
+    ///   their hierarchy references bind with the assembly, the members of a type only when native first uses them,
+    ///   see BindTypeMembers. Attribute records are not bound, native reads attributes through the regular calls the
+    ///   first time it asks for them, so binding never instantiates one. Every record is checked against what it
+    ///   resolved to, a mismatch rejects the image or, for members, the binding of that type.
+    ///
+    /// Holds no state between calls, types bound earlier are read back from the ids native keeps for the image.
+    private sealed unsafe class ImageBinder {
+      private readonly byte* data;
+      private readonly Header header;
+      private readonly Int32* ids;
+      private readonly Int32 count;
+
+      private readonly Int32 externals_base;
+      private readonly Int32 methods_base;
+      private readonly Int32 fields_base;
+      private readonly Int32 properties_base;
+      private readonly Int32 attributes_base;
+
+      /// modules do not resolve property tokens, the properties of each declaring type are indexed once per binder
+      private readonly Dictionary<Type, Dictionary<Int32, PropertyInfo>> declared_properties = new();
+
+      internal ImageBinder(byte* data, Int32 size, Int32* ids, Int32 count) {
+        this.data = data;
+        this.ids = ids;
+        this.count = count;
+
+        if (size < sizeof(Header)) {
+          throw new ArgumentException($"Metadata image of {size} bytes has no header", nameof(size));
+        }
+        header = *(Header*)data;
+
+        externals_base = (Int32)header.Types.Count;
+        methods_base = externals_base + (Int32)header.Externals.Count;
+        fields_base = methods_base + (Int32)header.Methods.Count;
+        properties_base = fields_base + (Int32)header.Fields.Count;
+        attributes_base = properties_base + (Int32)header.Properties.Count;
+      }
+
+      private bool Matches(Assembly asm) {
+        return header.Magic == kMagic && header.Version == kVersion && header.Key.Equals(KeyOf(asm)) &&
+               count == attributes_base + (Int32)header.Attributes.Count;
+      }
+
+      private ReadOnlySpan<T> Records<T>(Section section) where T : unmanaged {
+        return new ReadOnlySpan<T>(data + section.Offset, (Int32)section.Count);
+      }
+
+      private ReadOnlySpan<T> Records<T>(Section section, Range range) where T : unmanaged {
+        return Records<T>(section).Slice((Int32)range.First, (Int32)range.Count);
+      }
+
+      private bool NameIs(UInt32 offset, string? name) {
+        var strings = Records<byte>(header.Strings);
+        if ((UInt64)offset + sizeof(UInt32) > (UInt64)strings.Length) {
+          return false;
+        }
+
+        UInt32 length = MemoryMarshal.Read<UInt32>(strings.Slice((Int32)offset));
+        if ((UInt64)offset + sizeof(UInt32) + length > (UInt64)strings.Length) {
+          return false;
+        }
+
+        return Encoding.UTF8.GetString(strings.Slice((Int32)offset + sizeof(UInt32), (Int32)length)) == (name ?? string.Empty);
+      }
+
+      /// slot of a type ref in ids, -1 when it points past the image
+      private Int32 SlotOf(UInt32 type_ref) {
+        if ((type_ref & kExternalType) == 0) {
+          return type_ref < header.Types.Count ? (Int32)type_ref : -1;
+        }
+
+        UInt32 idx = type_ref & ~kExternalType;
+        return idx < header.Externals.Count ? externals_base + (Int32)idx : -1;
+      }
+
+      private Type? TypeAt(UInt32 type_ref) {
+        Int32 slot = type_ref == kNoType ? -1 : SlotOf(type_ref);
+        if (slot < 0 || ids[slot] == -1) {
+          return null;
+        }
+
+        return InteropInterface.cached_types.TryGet(ids[slot], out var type) ? type : null;
+      }
+
+      /// externals are bound by the first record that references them, every later reference has to agree
+      private bool BindRef(UInt32 type_ref, Type? actual) {
+        if (type_ref == kNoType || actual == null) {
+          return type_ref == kNoType && actual == null;
+        }
+
+        Int32 slot = SlotOf(type_ref);
+        if (slot < 0) {
+          return false;
+        }
+
+        if (ids[slot] == -1 && slot >= externals_base) {
+          var record = Records<ExternalTypeRecord>(header.Externals)[slot - externals_base];
+          if (!NameIs(record.FullName, actual.FullName ?? actual.Name)) {
+            return false;
+          }
+
+          ids[slot] = InteropInterface.cached_types.Add(actual);
+          return true;
+        }
+
+        return TypeAt(type_ref) == actual;
+      }
+
+      private bool BindAncestors(Range range, Type type) {
+        var refs = Records<UInt32>(header.TypeRefs, range);
+
+        /// recorded root first, walked from the type up
+        Int32 i = refs.Length;
+        for (Type? base_type = type.BaseType; base_type != null; base_type = base_type.BaseType) {
+          if (--i < 0 || !BindRef(refs[i], base_type)) {
+            return false;
+          }
+        }
+
+        return i == 0;
+      }
+
+      private bool BindInterfaces(Range range, Type type) {
+        var refs = Records<UInt32>(header.TypeRefs, range);
+        var interfaces = type.GetInterfaces();
+        if (interfaces.Length != refs.Length) {
+          return false;
+        }
+
+        for (Int32 i = 0; i < refs.Length; i++) {
+          if (!BindRef(refs[i], interfaces[i])) {
+            return false;
+          }
+        }
+
+        return true;
+      }
+
+      /// a member found in its declaring type, seen through owner, the same object Build got from owner
+      private static T? Reflect<T>(Type owner, MemberInfo? declared) where T : MemberInfo {
+        return declared == null ? null : owner.GetMemberWithSameMetadataDefinitionAs(declared) as T;
+      }
+
+      private PropertyInfo? DeclaredProperty(Type? declaring, Int32 token) {
+        if (declaring == null) {
+          return null;
+        }
+
+        if (!declared_properties.TryGetValue(declaring, out var by_token)) {
+          by_token = new Dictionary<Int32, PropertyInfo>();
+          foreach (var pinfo in declaring.GetProperties(kMemberFlags | BindingFlags.DeclaredOnly)) {
+            by_token[pinfo.MetadataToken] = pinfo;
+          }
+          declared_properties.Add(declaring, by_token);
+        }
+
+        return by_token.GetValueOrDefault(token);
+      }
+
+      private bool BindMethods(Range range, Type owner) {
+        var records = Records<MethodRecord>(header.Methods, range);
+        for (Int32 i = 0; i < records.Length; i++) {
+          ref readonly var record = ref records[i];
+
+          var minfo = Reflect<MethodInfo>(owner, TypeAt(record.DeclaringType)?.Module.ResolveMethod(record.Token));
+          if (minfo == null || !NameIs(record.Name, minfo.Name) || minfo.IsStatic != (record.IsStatic != 0) ||
+              !BindRef(record.ReturnType, minfo.ReturnType)) {
+            return false;
+          }
+
+          /// parameter types are what binds the externals only member signatures reference
+          var param_refs = Records<UInt32>(header.TypeRefs, record.Params);
+          var parameters = minfo.GetParameters();
+          if (parameters.Length != param_refs.Length) {
+            return false;
+          }
+
+          for (Int32 p = 0; p < parameters.Length; p++) {
+            if (!BindRef(param_refs[p], parameters[p].ParameterType)) {
+              return false;
+            }
+          }
+
+          ids[methods_base + range.First + i] = InteropInterface.cached_methods.Add(minfo);
+        }
+
+        return true;
+      }
+
+      private bool BindFields(Range range, Type owner) {
+        var records = Records<FieldRecord>(header.Fields, range);
+        for (Int32 i = 0; i < records.Length; i++) {
+          ref readonly var record = ref records[i];
+
+          var finfo = Reflect<FieldInfo>(owner, TypeAt(record.DeclaringType)?.Module.ResolveField(record.Token));
+          if (finfo == null || !NameIs(record.Name, finfo.Name) || finfo.IsStatic != (record.IsStatic != 0) ||
+              !BindRef(record.Type, finfo.FieldType)) {
+            return false;
+          }
+          ids[fields_base + range.First + i] = InteropInterface.cached_fields.Add(finfo);
+        }
+
+        return true;
+      }
+
+      private bool BindProperties(Range range, Type owner) {
+        var records = Records<PropertyRecord>(header.Properties, range);
+        for (Int32 i = 0; i < records.Length; i++) {
+          ref readonly var record = ref records[i];
+
+          var property = Reflect<PropertyInfo>(owner, DeclaredProperty(TypeAt(record.DeclaringType), record.Token));
+          if (property == null || !NameIs(record.Name, property.Name) || !BindRef(record.Type, property.PropertyType)) {
+            return false;
+          }
+          ids[properties_base + range.First + i] = InteropInterface.cached_properties.Add(property);
+        }
+
+        return true;
+      }
+
+      /// binds every type record and the types its hierarchy references, members and attributes are left at -1
+      internal bool BindTypes(Assembly asm) {
+        if (!Matches(asm)) {
+          return false;
+        }
+
+        new Span<Int32>(ids, count).Fill(-1);
+
+        var types = Records<TypeRecord>(header.Types);
+        Module module = asm.ManifestModule;
+        for (Int32 i = 0; i < types.Length; i++) {
+          Type type = module.ResolveType(types[i].Token);
+          if (!NameIs(types[i].FullName, type.FullName ?? type.Name)) {
+            return false;
+          }
+
+          ids[i] = InteropInterface.cached_types.Add(type);
+        }
+
+        for (Int32 i = 0; i < types.Length; i++) {
+          ref readonly var record = ref types[i];
+          Type type = TypeAt((UInt32)i)!;
+
+          bool bound = BindRef(record.BaseType, type.BaseType) &&
+                       BindRef(record.ElementType, type.HasElementType ? type.GetElementType() : null) &&
+                       BindAncestors(record.Ancestors, type) &&
+                       BindInterfaces(record.Interfaces, type);
+          if (!bound) {
+            return false;
+          }
+        }
+
+        return true;
+      }
+
+      /// binds the methods, fields and properties of one type record of an image BindTypes accepted. Inherited
+      ///   members are declared in an ancestor, which BindTypes already bound
+      internal bool BindMembers(Int32 type_index) {
+        if (count != attributes_base + (Int32)header.Attributes.Count || (UInt32)type_index >= header.Types.Count) {
+          return false;
+        }
+
+        Type? owner = TypeAt((UInt32)type_index);
+        if (owner == null) {
+          return false;
+        }
+
+        ref readonly var record = ref Records<TypeRecord>(header.Types)[type_index];
+        return BindMethods(record.Methods, owner) && BindFields(record.Fields, owner) && BindProperties(record.Properties, owner);
+      }
+    }
+
+    [UnmanagedCallersOnly]
+    internal static unsafe void ExportAssemblyMetadata(Int32 asm_id, IntPtr* out_image, Int32* out_size) {
+      using var timing = StartupTimings.Measure(ManagedPhase.ExportMetadata);
+      try {
+        if (out_image == null || out_size == null) {
+          throw new ArgumentNullException(out_image == null ? nameof(out_image) : nameof(out_size));
+        }
+
+        *out_image = IntPtr.Zero;
+        *out_size = 0;
+
+        if (!AssemblyLoader.TryGetAssembly(asm_id, out var asm) || asm == null) {
+          LogMessage($"Couldn't export metadata for assembly '{asm_id}', assembly not found", MessageLevel.Error);
+          return;
+        }
+
+        *out_image = Build(asm_id, asm, out var size);
+        *out_size = size;
+      } catch (Exception ex) {
+        HandleException(ex);
+      }
+    }
+
+    [UnmanagedCallersOnly]
+    internal static unsafe NBool32 BindAssemblyMetadata(Int32 asm_id, IntPtr image, Int32 size, Int32* out_ids, Int32 count) {
+      using var timing = StartupTimings.Measure(ManagedPhase.BindMetadata);
+      try {
+        if (image == IntPtr.Zero || out_ids == null) {
+          throw new ArgumentNullException(image == IntPtr.Zero ? nameof(image) : nameof(out_ids));
+        }
+
+        if (!AssemblyLoader.TryGetAssembly(asm_id, out var asm) || asm == null) {
+          LogMessage($"Couldn't bind metadata for assembly '{asm_id}', assembly not found", MessageLevel.Error);
+          return false;
+        }
+
+        bool bound;
+        try {
+          bound = new ImageBinder((byte*)image, size, out_ids, count).BindTypes(asm);
+        } catch (Exception e) when (e is ArgumentException or BadImageFormatException or TypeLoadException or MissingMemberException) {
+          /// a token that no longer resolves is a stale image, not an error
+          bound = false;
+        }
+
+        if (!bound) {
+          LogMessage($"Cached metadata of '{asm.GetName().Name}' does not match the loaded assembly, exporting it again", MessageLevel.Warning);
+        }
+        return bound;
+      } catch (Exception ex) {
+        HandleException(ex);
+        return false;
+      }
+    }
+
+    /// ids are the ones BindAssemblyMetadata filled for the same image, the member ids of the type are added to them
+    [UnmanagedCallersOnly]
+    internal static unsafe NBool32 BindTypeMembers(Int32 asm_id, IntPtr image, Int32 size, Int32 type_index, Int32* ids, Int32 count) {
+      using var timing = StartupTimings.Measure(ManagedPhase.BindMetadata);
+      try {
+        if (image == IntPtr.Zero || ids == null) {
+          throw new ArgumentNullException(image == IntPtr.Zero ? nameof(image) : nameof(ids));
+        }
+
+        bool bound;
+        try {
+          bound = new ImageBinder((byte*)image, size, ids, count).BindMembers(type_index);
+        } catch (Exception e) when (e is ArgumentException or BadImageFormatException or TypeLoadException or MissingMemberException) {
+          bound = false;
+        }
+
+        if (!bound) {
+          LogMessage($"Cached members of type record {type_index} of assembly '{asm_id}' do not resolve, reading them through reflection", MessageLevel.Warning);
+        }
+        return bound;
+      } catch (Exception ex) {
+        HandleException(ex);
+        return false;
+      }
+    }
+
+    [UnmanagedCallersOnly]
+    internal static unsafe void GetMetadataKey(Int32 asm_id, CacheKey* out_key) {
+      try {
+        if (out_key == null) {
+          throw new ArgumentNullException(nameof(out_key));
+        }
+
+        *out_key = default;
+        if (!AssemblyLoader.TryGetAssembly(asm_id, out var asm) || asm == null) {
+          LogMessage($"Couldn't get metadata key of assembly '{asm_id}', assembly not found", MessageLevel.Error);
+          return;
+        }
+
+        *out_key = KeyOf(asm);
+      } catch (Exception ex) {
+        HandleException(ex);
+      }
+    }
+#nullable disable
+  }
+
+}
@@ -0,0 +1,125 @@
+using System;
+using System.Collections.Concurrent;
+using System.Collections.Generic;
+using System.Reflection;
+using System.Runtime.CompilerServices;
+using System.Text;
+
+using DotOther.Managed.Interop;
+
+namespace DotOther.Managed {
+
+  /// Mirrors util::MethodSignature in core/utilities.hpp. Native hashes its argument list at compile time and
+  ///   managed hashes each MethodBase once, so picking an overload is a single integer compare.
+  ///
+  /// hash = FNV-1a over (Int32 argc, then per parameter: Int32 kind, UInt32 size, UInt64 type_hash), little endian.
+  ///   size and type_hash are only set for structs, type_hash being the FNV-1a hash of the managed full name
+  ///   that DOTOTHER_MANAGED_STRUCT registers on the native side.
+  internal static class MethodSignature {
+    private const UInt64 kFnvOffsetBasis = 14695981039346656037;
+    private const UInt64 kFnvPrime = 1099511628211;
+
+    /// weakly keyed, a cached hash does not keep an unloaded context's methods alive
+    private static readonly ConditionalWeakTable<MethodBase, StrongBox<UInt64>> signatures = new();
+
+    private static readonly Dictionary<Type, ManagedType> primitive_types = new() {
+      { typeof(sbyte), ManagedType.SByte },
+      { typeof(byte), ManagedType.Byte },
+      { typeof(short), ManagedType.Short },
+      { typeof(ushort), ManagedType.UShort },
+      { typeof(int), ManagedType.Int },
+      { typeof(uint), ManagedType.UInt },
+      { typeof(long), ManagedType.Long },
+      { typeof(ulong), ManagedType.ULong },
+      { typeof(float), ManagedType.Float },
+      { typeof(double), ManagedType.Double },
+      { typeof(bool), ManagedType.Bool },
+      { typeof(NBool32), ManagedType.Bool },
+      { typeof(IntPtr), ManagedType.Pointer },
+      { typeof(UIntPtr), ManagedType.Pointer },
+      { typeof(string), ManagedType.String },
+      { typeof(NString), ManagedType.String },
+    };
+
+    internal static UInt64 Of(MethodBase method) {
+      return signatures.GetValue(method, static m => new StrongBox<UInt64>(Compute(m))).Value;
+    }
+
+    internal static ManagedType KindOf(Type type) {
+      if (type.IsPointer || type.IsByRef) {
+        return ManagedType.Pointer;
+      }
+
+      if (type.IsEnum) {
+        type = Enum.GetUnderlyingType(type);
+      }
+
+      if (primitive_types.TryGetValue(type, out var kind)) {
+        return kind;
+      }
+
+      if (type.IsArray || (type.IsGenericType && type.GetGenericTypeDefinition() == typeof(NArray<>))) {
+        return ManagedType.Array;
+      }
+
+      if (typeof(NObject).IsAssignableFrom(type)) {
+        return ManagedType.NativeObject;
+      }
+
+      if (!type.IsValueType) {
+        return ManagedType.Object;
+      }
+
+      if (!type.IsPrimitive && !type.ContainsGenericParameters) {
+        return ManagedType.Struct;
+      }
+
+      return ManagedType.Unknown;
+    }
+
+    internal static UInt64 HashName(string? name) {
+      UInt64 hash = kFnvOffsetBasis;
+      if (name == null) {
+        return hash;
+      }
+
+      foreach (byte b in Encoding.UTF8.GetBytes(name)) {
+        hash ^= b;
+        hash *= kFnvPrime;
+      }
+      return hash;
+    }
+
+    private static UInt64 Compute(MethodBase method) {
+      ParameterInfo[] parameters = method.GetParameters();
+
+      UInt64 hash = Combine(kFnvOffsetBasis, (UInt32)parameters.Length, 4);
+      foreach (var param in parameters) {
+        Type type = param.ParameterType;
+        ManagedType kind = KindOf(type);
+
+        UInt32 size = 0;
+        UInt64 type_hash = 0;
+        if (kind == ManagedType.Struct) {
+          size = (UInt32)DotOtherMarshal.NativeSizeOf(type);
+          type_hash = HashName(type.FullName);
+        }
+
+        hash = Combine(hash, (UInt32)kind, 4);
+        hash = Combine(hash, size, 4);
+        hash = Combine(hash, type_hash, 8);
+      }
+
+      return hash;
+    }
+
+    private static UInt64 Combine(UInt64 hash, UInt64 value, Int32 width) {
+      for (Int32 i = 0; i < width; i++) {
+        hash ^= (byte)(value >> (i * 8));
+        hash *= kFnvPrime;
+      }
+      return hash;
+    }
+  }
+
+}
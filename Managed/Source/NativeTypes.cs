@@ -2,6 +2,7 @@ using System;
 using System.Collections;
 using System.Collections.Generic;
 using System.Diagnostics.CodeAnalysis;
+using System.Runtime.CompilerServices;
 using System.Runtime.InteropServices;
 
 namespace DotOther.Managed {
@@ -18,10 +19,10 @@ namespace DotOther.Managed {
   }
 
   public sealed class NArrayEnumerator<T> : IEnumerator<T> {
-    private readonly T[] array;
+    private readonly NArray<T> array;
     private Int32 index;
 
-    public NArrayEnumerator(T[] array) {
+    public NArrayEnumerator(NArray<T> array) {
       this.array = array;
       index = -1;
     }
@@ -40,26 +41,46 @@ namespace DotOther.Managed {
       GC.SuppressFinalize(this);
     }
     object IEnumerator.Current => Current!;
-    public T Current => array[index];
+    public T Current => array[index]!;
   }
   
+  /// Contiguous array shared with native code, layout-compatible with dotother::NArray:
+  ///   { IntPtr data, Int32 length, NBool32 owner }
+  ///
+  /// An owning array was allocated from the HGlobal heap and is released by Dispose, a view never frees.
+  ///   Copies of the struct alias the same buffer, only one of them may be disposed.
   [StructLayout(LayoutKind.Sequential, Pack = 1)]
-  public sealed class NArray<T> : IEnumerable<T> {
-    private readonly IntPtr array;
-    private readonly Int32 length;
-    private NBool32 disposed;
+  public struct NArray<T> : IEnumerable<T>, IDisposable {
+    private IntPtr array;
+    private Int32 length;
+    private NBool32 owner;
+
+    private static readonly bool is_unmanaged = !RuntimeHelpers.IsReferenceOrContainsReferences<T>();
+    private static readonly Int32 element_size = is_unmanaged ? Unsafe.SizeOf<T>() : Marshal.SizeOf<T>();
 
-    public Int32 Length => length;
+    public readonly Int32 Length => length;
+    public readonly bool IsOwner => owner;
 
-    public NArray(IntPtr len) {
-      this.array = Marshal.AllocHGlobal(len * Marshal.SizeOf<T>());
-      this.length = Marshal.ReadInt32(len);
+    public NArray(Int32 length) {
+      this.array = Marshal.AllocHGlobal(Math.Max(length * element_size, 1));
+      this.length = length;
+      this.owner = true;
+
+      unsafe {
+        new Span<byte>(this.array.ToPointer(), length * element_size).Clear();
+      }
     }
 
 #nullable enable
-    public NArray([DisallowNull] T?[] arr) {
-      this.array = Marshal.AllocHGlobal(arr.Length * Marshal.SizeOf<T>());
-      this.length = arr.Length;
+    public NArray([DisallowNull] T?[] arr) 
+        : this(arr.Length) {
+      if (is_unmanaged) {
+        unsafe {
+          var bytes = MemoryMarshal.CreateReadOnlySpan(ref Unsafe.As<T?, byte>(ref MemoryMarshal.GetArrayDataReference(arr)), arr.Length * element_size);
+          bytes.CopyTo(new Span<byte>(this.array.ToPointer(), arr.Length * element_size));
+        }
+        return;
+      }
 
       for (int i = 0; i < arr.Length; i++) {
         var elem = arr[i];
@@ -67,51 +88,85 @@ namespace DotOther.Managed {
           continue;
         }
 
-        Marshal.StructureToPtr(arr[i]!, IntPtr.Add(this.array, i * Marshal.SizeOf<T>()), false);
+        Marshal.StructureToPtr(arr[i]!, IntPtr.Add(this.array, i * element_size), false);
       }
     }
 
     internal NArray(IntPtr array, int length) {
       this.array = array;
       this.length = length;
+      this.owner = false;
     }
 
-    public T[] ToArray() {
-      Span<T> data = Span<T>.Empty;
-      if (array != IntPtr.Zero && length > 0) {
-        unsafe {
-          data = new Span<T>(array.ToPointer(), length);
-        }
+    public readonly T[] ToArray() {
+      if (array == IntPtr.Zero || length == 0) {
+        return Array.Empty<T>();
+      }
+
+      if (is_unmanaged) {
+        return ToReadOnlySpan().ToArray();
       }
-      return data.ToArray();
+
+      var res = new T[length];
+      for (int i = 0; i < length; i++) {
+        res[i] = this[i]!;
+      }
+      return res;
     }
 
-    public Span<T> ToSpan() {
+    public readonly Span<T> ToSpan() {
+      if (!is_unmanaged) {
+        throw new NotSupportedException($"Cannot create a span over native memory for managed element type '{typeof(T).FullName}'");
+      }
+
       unsafe {
         return new Span<T>(array.ToPointer(), length);
       }
     }
 
-    public ReadOnlySpan<T> ToReadOnlySpan() => ToSpan();
+    public readonly ReadOnlySpan<T> ToReadOnlySpan() => ToSpan();
 
     public void Dispose() {
-      if (!disposed) {
-        if (array != IntPtr.Zero) {
-          Marshal.FreeHGlobal(array);
-        }
-
-        disposed = true;
+      if (owner && array != IntPtr.Zero) {
+        Marshal.FreeHGlobal(array);
       }
 
-      GC.SuppressFinalize(this);
+      array = IntPtr.Zero;
+      length = 0;
+      owner = false;
     }
 
-    public IEnumerator<T> GetEnumerator() => new NArrayEnumerator<T>(this);
-    IEnumerator IEnumerable.GetEnumerator() => new NArrayEnumerator<T>(this);
+    public readonly IEnumerator<T> GetEnumerator() => new NArrayEnumerator<T>(this);
+    readonly IEnumerator IEnumerable.GetEnumerator() => new NArrayEnumerator<T>(this);
 
-    public T? this[Int32 index] {
-      get => Marshal.PtrToStructure<T>(IntPtr.Add(array, index * Marshal.SizeOf<T>()));
-      set => Marshal.StructureToPtr<T>(value!, IntPtr.Add(array, index * Marshal.SizeOf<T>()), false);
+    public readonly T? this[Int32 index] {
+      get {
+        if ((UInt32)index >= (UInt32)length) {
+          throw new IndexOutOfRangeException();
+        }
+
+        unsafe {
+          if (is_unmanaged) {
+            return Unsafe.Add(ref Unsafe.AsRef<T>(array.ToPointer()), index);
+          }
+        }
+
+        return Marshal.PtrToStructure<T>(IntPtr.Add(array, index * element_size));
+      }
+      set {
+        if ((UInt32)index >= (UInt32)length) {
+          throw new IndexOutOfRangeException();
+        }
+
+        unsafe {
+          if (is_unmanaged) {
+            Unsafe.Add(ref Unsafe.AsRef<T>(array.ToPointer()), index) = value!;
+            return;
+          }
+        }
+
+        Marshal.StructureToPtr<T>(value!, IntPtr.Add(array, index * element_size), false);
+      }
     }
 
     public static implicit operator T[](NArray<T> array) => array.ToArray();
@@ -0,0 +1,58 @@
+using System;
+using System.Diagnostics;
+using System.Runtime.InteropServices;
+using System.Threading;
+
+namespace DotOther.Managed {
+
+  using static DotOtherHost;
+
+  /// mirrors dotother::ManagedPhase in hosting/startup_profile.hpp
+  internal enum ManagedPhase {
+    EntryPoint,
+    NetCoreAssemblies,
+    LoadAssembly,
+    ExportMetadata,
+    BindMetadata,
+    Count
+  }
+
+  /// Managed half of the startup report. Phases accumulate wall time until the process exits, phases that run
+  ///   on several threads at once (metadata export during a parallel load) report the sum over threads.
+  internal static class StartupTimings {
+    private static readonly Int64[] ticks = new Int64[(Int32)ManagedPhase.Count];
+
+    internal readonly struct Scope : IDisposable {
+      private readonly ManagedPhase phase;
+      private readonly Int64 start;
+
+      internal Scope(ManagedPhase phase) {
+        this.phase = phase;
+        start = Stopwatch.GetTimestamp();
+      }
+
+      public void Dispose() {
+        Interlocked.Add(ref ticks[(Int32)phase], Stopwatch.GetTimestamp() - start);
+      }
+    }
+
+    internal static Scope Measure(ManagedPhase phase) => new(phase);
+
+    [UnmanagedCallersOnly]
+    internal static unsafe void GetStartupTimings(Int64* out_ns, Int32 count) {
+      try {
+        if (out_ns == null) {
+          throw new ArgumentNullException(nameof(out_ns));
+        }
+
+        for (Int32 i = 0; i < Math.Min(count, ticks.Length); i++) {
+          Int64 phase_ticks = Interlocked.Read(ref ticks[i]);
+          out_ns[i] = (Int64)(phase_ticks * (1_000_000_000.0 / Stopwatch.Frequency));
+        }
+      } catch (Exception e) {
+        HandleException(e);
+      }
+    }
+  }
+
+}
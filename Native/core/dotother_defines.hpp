@@ -24,6 +24,7 @@
 #include <Windows.h>
 #define DOTOTHER_CALLTYPE __cdecl
 #define DOTOTHER_HOSTFXR_NAME "hostfxr.dll"
+#define DOTOTHER_NETHOST_NAME "nethost.dll"
 
 #ifdef _WCHAR_T_DEFINED
 #define DOTOTHER_WIDE_CHARS
@@ -36,7 +37,8 @@
 #ifdef DOTOTHER_LINUX
 #define DOTOTHER_CALLTYPE
 #define DODOTOTHER_STR(s) s
-#define DO_HOSTFXR_NAME "libhostfxr.so"
+#define DOTOTHER_HOSTFXR_NAME "libhostfxr.so"
+#define DOTOTHER_NETHOST_NAME "libnethost.so"
 #endif
 
 #define DOTOTHER_DOTNET_TARGET_VERSION_MAJOR 8
@@ -116,6 +118,12 @@ namespace dotother {
     BOOL,
 
     POINTER,
+
+    STRING,
+    ARRAY,
+    OBJECT,
+    STRUCT,
+    NATIVE_OBJECT,
   };
 
   enum class AssemblyLoadStatus {
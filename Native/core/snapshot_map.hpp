@@ -0,0 +1,131 @@
+/**
+ * \file core/snapshot_map.hpp
+ **/
+#ifndef DOTOTHER_SNAPSHOT_MAP_HPP
+#define DOTOTHER_SNAPSHOT_MAP_HPP
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+
+namespace dotother {
+
+  /// Read-mostly hash map. Each shard publishes an immutable map through an atomic shared_ptr, readers load the
+  ///   current snapshot (one reference count bump) and never wait on a writer. Writers copy the shards they touch,
+  ///   insert into (or erase from) the copies and publish them when the Writer commits, so a batch of inserts
+  ///   costs one copy per touched shard.
+  ///
+  /// Writers must be serialized by the owner, readers may run at any time. Snapshots a reader still holds stay
+  ///   alive until it drops them.
+  template <typename K, typename V, typename Hash = std::hash<K>, typename Eq = std::equal_to<K>, size_t ShardCount = 64>
+  class SnapshotMap {
+   public:
+    using Map = std::unordered_map<K, V, Hash, Eq>;
+
+    SnapshotMap() {
+      for (auto& shard : shards) {
+        shard.store(std::make_shared<const Map>(), std::memory_order_relaxed);
+      }
+    }
+
+    SnapshotMap(const SnapshotMap&) = delete;
+    SnapshotMap& operator=(const SnapshotMap&) = delete;
+
+    /// value for key or a value-initialized V when missing
+    template <typename Key>
+    V Find(const Key& key) const {
+      std::shared_ptr<const Map> snapshot = shards[ShardOf(key)].load(std::memory_order_acquire);
+      auto itr = snapshot->find(key);
+      return itr != snapshot->end() ? itr->second : V{};
+    }
+
+    size_t Size() const {
+      size_t size = 0;
+      for (const auto& shard : shards) {
+        size += shard.load(std::memory_order_acquire)->size();
+      }
+      return size;
+    }
+
+    template <typename Fn>
+    void ForEach(Fn&& fn) const {
+      for (const auto& shard : shards) {
+        std::shared_ptr<const Map> snapshot = shard.load(std::memory_order_acquire);
+        for (const auto& [key, value] : *snapshot) {
+          fn(key, value);
+        }
+      }
+    }
+
+    class Writer {
+     public:
+      explicit Writer(SnapshotMap& map)
+          : map(map) {}
+
+      ~Writer() {
+        Commit();
+      }
+
+      Writer(const Writer&) = delete;
+      Writer& operator=(const Writer&) = delete;
+
+      /// sees inserts staged by this writer
+      template <typename Key>
+      V Find(const Key& key) const {
+        size_t shard = ShardOf(key);
+        const Map& current = staged[shard] != nullptr ? *staged[shard] : *map.shards[shard].load(std::memory_order_acquire);
+
+        auto itr = current.find(key);
+        return itr != current.end() ? itr->second : V{};
+      }
+
+      /// keeps the existing value when key is already present
+      bool Insert(K key, V value) {
+        return Stage(ShardOf(key)).try_emplace(std::move(key), std::move(value)).second;
+      }
+
+      bool Erase(const K& key) {
+        return Stage(ShardOf(key)).erase(key) > 0;
+      }
+
+      void Commit() {
+        for (size_t i = 0; i < ShardCount; ++i) {
+          if (staged[i] != nullptr) {
+            map.shards[i].store(std::shared_ptr<const Map>(std::move(staged[i])), std::memory_order_release);
+          }
+        }
+      }
+
+     private:
+      SnapshotMap& map;
+      std::array<std::shared_ptr<Map>, ShardCount> staged{};
+
+      Map& Stage(size_t shard) {
+        if (staged[shard] == nullptr) {
+          staged[shard] = std::make_shared<Map>(*map.shards[shard].load(std::memory_order_acquire));
+        }
+        return *staged[shard];
+      }
+    };
+
+   private:
+    std::array<std::atomic<std::shared_ptr<const Map>>, ShardCount> shards;
+
+    /// shards pick from the high bits of a remixed hash, keys in one shard still spread over all its buckets
+    template <typename Key>
+    static size_t ShardOf(const Key& key) {
+      uint64_t x = static_cast<uint64_t>(Hash{}(key));
+      x ^= x >> 33;
+      x *= 0xFF51AFD7ED558CCDull;
+      x ^= x >> 33;
+      return static_cast<size_t>(x >> 40) % ShardCount;
+    }
+  };
+
+}  // namespace dotother
+
+#endif  // !DOTOTHER_SNAPSHOT_MAP_HPP
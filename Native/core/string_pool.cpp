@@ -0,0 +1,68 @@
+/**
+ * \file core/string_pool.cpp
+ **/
+#include "core/string_pool.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace dotother {
+
+  namespace {
+
+    /// names are short, one block holds a few thousand of them
+    constexpr size_t kBlockSize = 64 * 1024;
+
+  }  // namespace
+
+  StringPool& StringPool::Instance() {
+    static StringPool instance;
+    return instance;
+  }
+
+  std::string_view StringPool::Intern(std::string_view str) {
+    if (str.empty()) {
+      return {};
+    }
+
+    std::scoped_lock lock(mutex);
+    if (auto itr = strings.find(str); itr != strings.end()) {
+      return *itr;
+    }
+
+    char* data = Allocate(str.size());
+    std::memcpy(data, str.data(), str.size());
+
+    std::string_view interned(data, str.size());
+    strings.insert(interned);
+    return interned;
+  }
+
+  size_t StringPool::Size() const {
+    std::scoped_lock lock(mutex);
+    return strings.size();
+  }
+
+  size_t StringPool::Bytes() const {
+    std::scoped_lock lock(mutex);
+    return block_bytes +
+           blocks.capacity() * sizeof(Block) +
+           strings.bucket_count() * sizeof(void*) +
+           strings.size() * (sizeof(std::string_view) + sizeof(void*));
+  }
+
+  char* StringPool::Allocate(size_t size) {
+    if (blocks.empty() || blocks.back().size - blocks.back().used < size) {
+      /// a name longer than a block gets a block of its own
+      size_t block_size = std::max(kBlockSize, size);
+      blocks.push_back(Block{ std::make_unique<char[]>(block_size), block_size, 0 });
+      block_bytes += block_size;
+    }
+
+    Block& block = blocks.back();
+    char* data = block.data.get() + block.used;
+    block.used += size;
+    return data;
+  }
+
+}  // namespace dotother
@@ -0,0 +1,61 @@
+/**
+ * \file core/string_pool.hpp
+ **/
+#ifndef DOTOTHER_STRING_POOL_HPP
+#define DOTOTHER_STRING_POOL_HPP
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+#include "core/utilities.hpp"
+
+namespace dotother {
+
+  /// Interned storage for type and member names. Every distinct string is copied once into a block the pool
+  ///   owns, blocks are never moved or freed, so the views Intern hands out stay valid for the life of the host
+  ///   and equal names share one copy.
+  ///
+  /// Safe for concurrent use, interning takes a lock. Callers keep the returned view rather than interning the
+  ///   same name again.
+  class StringPool {
+   public:
+    static StringPool& Instance();
+
+    std::string_view Intern(std::string_view str);
+
+    /// distinct strings interned
+    size_t Size() const;
+    /// bytes held by the blocks and the lookup set
+    size_t Bytes() const;
+
+   private:
+    StringPool() = default;
+    ~StringPool() = default;
+
+    StringPool(StringPool&&) = delete;
+    StringPool(const StringPool&) = delete;
+    StringPool& operator=(StringPool&&) = delete;
+    StringPool& operator=(const StringPool&) = delete;
+
+    struct Block {
+      std::unique_ptr<char[]> data;
+      size_t size = 0;
+      size_t used = 0;
+    };
+
+    std::vector<Block> blocks;
+    std::unordered_set<std::string_view, util::StringHash, std::equal_to<>> strings;
+    size_t block_bytes = 0;
+
+    mutable std::mutex mutex;
+
+    char* Allocate(size_t size);
+  };
+
+}  // namespace dotother
+
+#endif  // !DOTOTHER_STRING_POOL_HPP
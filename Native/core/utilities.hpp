@@ -4,9 +4,15 @@
 #ifndef DOTOTHER_NATIVE_UTILITIES_HPP
 #define DOTOTHER_NATIVE_UTILITIES_HPP
 
+#include <array>
+#include <concepts>
+#include <cstdint>
 #include <iostream>
 #include <source_location>
+#include <span>
 #include <string_view>
+#include <type_traits>
+#include <utility>
 
 #include "core/dotother_defines.hpp"
 #include "core/hook_definitions.hpp"
@@ -89,53 +95,216 @@ namespace dotother {
 
 #define DOTOTHER_LOG(do_str, level, ...) dotother::util::print(do_str, level, std::source_location::current() __VA_OPT__(, ) __VA_ARGS__)
 
+    constexpr uint64_t kFnvOffsetBasis = 14695981039346656037ull;
+    constexpr uint64_t kFnvPrime = 1099511628211ull;
+
+    template <std::integral T>
+    constexpr uint64_t HashCombine(uint64_t hash, T value) {
+      using U = std::make_unsigned_t<T>;
+      U bits = static_cast<U>(value);
+      for (size_t i = 0; i < sizeof(T); ++i) {
+        hash ^= static_cast<uint8_t>(bits >> (i * 8));
+        hash *= kFnvPrime;
+      }
+      return hash;
+    }
+
+    /// FNV-1a, mirrored by DotOther.Managed.MethodSignature so hashes computed on either side agree
+    constexpr uint64_t HashString(std::string_view str, uint64_t hash = kFnvOffsetBasis) {
+      for (char c : str) {
+        hash ^= static_cast<uint8_t>(c);
+        hash *= kFnvPrime;
+      }
+      return hash;
+    }
+
+    /// transparent hash, lets string keyed maps be probed with a string_view without building a std::string
+    struct StringHash {
+      using is_transparent = void;
+
+      size_t operator()(std::string_view str) const {
+        return static_cast<size_t>(HashString(str));
+      }
+    };
+
+    /// splits a managed full name into namespace and type name, nested and generic types keep their suffix:
+    ///   "A.B.Outer+Inner" => { "A.B", "Outer+Inner" }
+    constexpr std::pair<std::string_view, std::string_view> SplitTypeName(std::string_view full_name) {
+      size_t end = full_name.find_first_of("+[");
+      size_t dot = full_name.rfind('.', end == std::string_view::npos ? end : end - 1);
+      if (dot == std::string_view::npos || (end != std::string_view::npos && dot > end)) {
+        return { {}, full_name };
+      }
+      return { full_name.substr(0, dot), full_name.substr(dot + 1) };
+    }
+
+  }  // namespace util
+
+  class NString;
+  class NScopedString;
+  class HostedObject;
+  class NObject;
+
+  template <typename T>
+  class NArray;
+
+  namespace util {
+    namespace detail {
+
+      template <typename T>
+      struct is_narray : std::false_type {};
+
+      template <typename T>
+      struct is_narray<NArray<T>> : std::true_type {};
+
+    }  // namespace detail
+
+    /// Maps a native struct onto a managed value type so it can be passed by value. Specialize through
+    ///   DOTOTHER_MANAGED_STRUCT, the native layout has to match the managed one byte for byte.
+    template <typename T>
+    struct ManagedStructTraits {
+      static constexpr bool is_managed = false;
+    };
+
+    template <typename T>
+    concept ManagedStruct = ManagedStructTraits<std::remove_cvref_t<T>>::is_managed;
+
+    /// native objects (or pointers to them) cross the boundary as their object_handle, managed resolves the handle
+    ///   through its own table of NObject wrappers
+    template <typename T>
+    concept NativeObjectRef = std::is_class_v<std::remove_pointer_t<std::remove_cvref_t<T>>> &&
+                              std::is_base_of_v<NObject, std::remove_pointer_t<std::remove_cvref_t<T>>>;
+
+    /// describes one parameter of a call signature, everything managed needs to pick an overload
+    struct ParamSignature {
+      ManagedType type = ManagedType::UNKNOWN;
+      uint32_t size = 0;
+      uint64_t type_hash = 0;
+    };
+
     template <typename TArg>
     constexpr ManagedType GetManagedType() {
-      if constexpr (std::is_pointer_v<std::remove_reference_t<TArg>>) {
+      using T = std::remove_cvref_t<TArg>;
+      if constexpr (std::same_as<T, HostedObject>) {
+        return ManagedType::OBJECT;
+      } else if constexpr (NativeObjectRef<T>) {
+        return ManagedType::NATIVE_OBJECT;
+      } else if constexpr (std::is_pointer_v<T>) {
         return ManagedType::POINTER;
-      } else if constexpr (std::same_as<TArg, uint8_t> || std::same_as<TArg, std::byte>) {
+      } else if constexpr (std::is_enum_v<T> && !std::same_as<T, std::byte>) {
+        return GetManagedType<std::underlying_type_t<T>>();
+      } else if constexpr (std::same_as<T, bool>) {
+        return ManagedType::BOOL;
+      } else if constexpr (std::same_as<T, std::byte>) {
         return ManagedType::BYTE;
-      } else if constexpr (std::same_as<TArg, uint16_t>) {
-        return ManagedType::USHORT;
-      } else if constexpr (std::same_as<TArg, uint32_t> || (std::same_as<TArg, unsigned long> && sizeof(TArg) == 4)) {
-        return ManagedType::UINT;
-      } else if constexpr (std::same_as<TArg, uint64_t> || (std::same_as<TArg, unsigned long> && sizeof(TArg) == 8)) {
-        return ManagedType::ULONG;
-      } else if constexpr (std::same_as<TArg, char8_t>) {
+      } else if constexpr (std::same_as<T, char8_t>) {
         return ManagedType::SBYTE;
-      } else if constexpr (std::same_as<TArg, int16_t>) {
-        return ManagedType::SHORT;
-      } else if constexpr (std::same_as<TArg, int32_t> || (std::same_as<TArg, long> && sizeof(TArg) == 4)) {
-        return ManagedType::INT;
-      } else if constexpr (std::same_as<TArg, int64_t> || (std::same_as<TArg, long> && sizeof(TArg) == 8)) {
-        return ManagedType::LONG;
-      } else if constexpr (std::same_as<TArg, float>) {
+      } else if constexpr (std::integral<T>) {
+        /// keyed on width rather than spelling so long/long long and friends land on the same managed type
+        constexpr bool is_signed = std::is_signed_v<T>;
+        if constexpr (sizeof(T) == 1) {
+          return is_signed ? ManagedType::SBYTE : ManagedType::BYTE;
+        } else if constexpr (sizeof(T) == 2) {
+          return is_signed ? ManagedType::SHORT : ManagedType::USHORT;
+        } else if constexpr (sizeof(T) == 4) {
+          return is_signed ? ManagedType::INT : ManagedType::UINT;
+        } else {
+          return is_signed ? ManagedType::LONG : ManagedType::ULONG;
+        }
+      } else if constexpr (std::same_as<T, float>) {
         return ManagedType::FLOAT;
-      } else if constexpr (std::same_as<TArg, double>) {
+      } else if constexpr (std::same_as<T, double>) {
         return ManagedType::DOUBLE;
-      } else if constexpr (std::same_as<TArg, bool>) {
-        return ManagedType::BOOL;
+      } else if constexpr (std::same_as<T, NString> || std::same_as<T, NScopedString>) {
+        return ManagedType::STRING;
+      } else if constexpr (detail::is_narray<T>::value) {
+        return ManagedType::ARRAY;
+      } else if constexpr (ManagedStruct<T>) {
+        return ManagedType::STRUCT;
       } else {
         return ManagedType::UNKNOWN;
       }
     }
 
-    template <typename A, size_t I>
-    inline void AddToArrayAt(const void** args_arr, ManagedType* param_types, A&& InArg) {
-      param_types[I] = GetManagedType<A>();
-      if constexpr (std::is_pointer_v<std::remove_reference_t<A>>) {
-        args_arr[I] = reinterpret_cast<const void*>(InArg);
+    template <typename TArg>
+    constexpr ParamSignature GetParamSignature() {
+      if constexpr (ManagedStruct<TArg>) {
+        using T = std::remove_cvref_t<TArg>;
+        return ParamSignature{
+          .type = ManagedType::STRUCT,
+          .size = static_cast<uint32_t>(sizeof(T)),
+          .type_hash = ManagedStructTraits<T>::type_hash,
+        };
+      } else {
+        return ParamSignature{
+          .type = GetManagedType<TArg>(),
+        };
+      }
+    }
+
+    constexpr uint64_t HashSignature(std::span<const ParamSignature> params) {
+      uint64_t hash = HashCombine(kFnvOffsetBasis, static_cast<int32_t>(params.size()));
+      for (const auto& param : params) {
+        hash = HashCombine(hash, static_cast<int32_t>(param.type));
+        hash = HashCombine(hash, param.size);
+        hash = HashCombine(hash, param.type_hash);
+      }
+      return hash;
+    }
+
+    /// compile-time description of a call's argument list, managed precomputes the same hash for every MethodInfo
+    ///   so overload selection is one integer compare
+    template <typename... Args>
+    struct MethodSignature {
+      static constexpr std::array<ParamSignature, sizeof...(Args)> params = { GetParamSignature<Args>()... };
+      static constexpr uint64_t hash = HashSignature(params);
+    };
+
+    template <typename... Args>
+    constexpr uint64_t SignatureHash() {
+      return MethodSignature<Args...>::hash;
+    }
+
+    /// What managed receives for one argument: objects travel as their handle value, pointers as themselves and
+    ///   everything else as the address of the caller's value, which managed reads exactly once
+    template <typename A>
+    inline const void* ToArgSlot(A&& arg) {
+      using T = std::remove_cvref_t<A>;
+      if constexpr (std::same_as<T, HostedObject>) {
+        return arg.Handle();
+      } else if constexpr (NativeObjectRef<T> && std::is_pointer_v<T>) {
+        return reinterpret_cast<const void*>(arg != nullptr ? arg->object_handle : 0);
+      } else if constexpr (NativeObjectRef<T>) {
+        return reinterpret_cast<const void*>(arg.object_handle);
+      } else if constexpr (std::is_pointer_v<T>) {
+        return reinterpret_cast<const void*>(arg);
       } else {
-        args_arr[I] = reinterpret_cast<const void*>(&InArg);
+        return reinterpret_cast<const void*>(&arg);
       }
     }
 
+    template <typename A, size_t I>
+    inline void AddToArrayAt(const void** args_arr, A&& InArg) {
+      args_arr[I] = ToArgSlot(std::forward<A>(InArg));
+    }
+
     template <typename... Args, size_t... Is>
-    inline void AddToArray(const void** args, ManagedType* parameters, Args&&... values, const std::index_sequence<Is...>&) {
-      (AddToArrayAt<Args, Is>(args, parameters, std::forward<Args>(values)), ...);
+    inline void AddToArray(const void** args, Args&&... values, const std::index_sequence<Is...>&) {
+      (AddToArrayAt<Args, Is>(args, std::forward<Args>(values)), ...);
     }
 
   }  // namespace util
 }  // namespace dotother
 
+/// Registers a native struct as the by-value counterpart of a managed value type, must be used at global scope
+///   e.g. DOTOTHER_MANAGED_STRUCT(glm::vec3, "DotOther.Tests.Vec3")
+#define DOTOTHER_MANAGED_STRUCT(type, managed_name)                                                                                 \
+  template <>                                                                                                                       \
+  struct dotother::util::ManagedStructTraits<type> {                                                                                \
+    static_assert(std::is_trivially_copyable_v<type>, "Managed structs are copied bytewise, " #type " must be trivially copyable"); \
+    static constexpr bool is_managed = true;                                                                                        \
+    static constexpr std::string_view name = managed_name;                                                                          \
+    static constexpr uint64_t type_hash = dotother::util::HashString(managed_name);                                                 \
+  }
+
 #endif  // !DOTOTHER_NATIVE_UTILITIES_HPP
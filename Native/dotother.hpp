@@ -9,9 +9,12 @@
 /// forward headers
 #include "hosting/attribute.hpp"
 #include "hosting/field.hpp"
+#include "hosting/metadata_image.hpp"
 #include "hosting/method.hpp"
+#include "hosting/native_array.hpp"
 #include "hosting/property.hpp"
 #include "hosting/type.hpp"
 #include "hosting/type_cache.hpp"
+#include "hosting/type_index.hpp"
 
 #endif  // !DOTOTHER_HPP
\ No newline at end of file
@@ -3,19 +3,42 @@
  **/
 #include "hosting/assembly.hpp"
 
+#include <algorithm>
+#include <atomic>
 #include <cstdint>
+#include <exception>
 #include <filesystem>
 #include <string_view>
+#include <thread>
 
 #include "core/utilities.hpp"
 
 #include "hosting/host.hpp"
 #include "hosting/interop_interface.hpp"
+#include "hosting/metadata_image.hpp"
 #include "hosting/native_string.hpp"
+#include "hosting/startup_profile.hpp"
 #include "hosting/type_cache.hpp"
 
 namespace dotother {
 
+  namespace {
+
+    /// <name>.<mvid>.<runtime version>.v<format version>.domd, a rebuilt assembly, another runtime or another image
+    ///   layout never hits a stale image
+    std::filesystem::path MetadataCacheFile(const std::filesystem::path& dir, const Assembly& assembly, const metadata::CacheKey& key) {
+      std::string name{ assembly.Name() };
+      name += '.';
+      for (uint8_t b : key.mvid) {
+        name += fmt::format("{:02x}", b);
+      }
+      name += fmt::format(".{}.{}.{}.v{}.domd", key.runtime_major, key.runtime_minor, key.runtime_build, metadata::kVersion);
+
+      return dir / name;
+    }
+
+  }  // namespace
+
   int32_t Assembly::GetId() const {
     return asm_id;
   }
@@ -34,7 +57,9 @@ namespace dotother {
 
   Type& Assembly::GetType(const std::string_view name, const std::string_view nspace) const {
     static Type null_type(-1);
-    Type* type = TypeCache::Instance().GetType(name);
+    Type* type = type_index.Empty() ?
+      TypeCache::Instance().GetType(TypeKeyView{ asm_id, nspace, name }) :
+      type_index.Find(nspace, name);
     return type != nullptr ?
       *type :
       null_type;
@@ -44,6 +69,22 @@ namespace dotother {
     return types;
   }
 
+  const TypeIndex& Assembly::GetTypeIndex() const {
+    return type_index;
+  }
+
+  void Assembly::Prefetch(std::span<const std::string_view> type_names, MemberCategory categories) const {
+    for (const auto& type_name : type_names) {
+      Type& type = GetType(type_name);
+      if (type.handle == -1) {
+        DOTOTHER_LOG(DO_STR("Assembly::Prefetch: type {} not found in {}"), MessageLevel::WARNING, type_name, name);
+        continue;
+      }
+
+      type.Prefetch(categories);
+    }
+  }
+
   std::string Assembly::GetAsmQualifiedName(const std::string_view klass, const std::string_view nspace) const {
     if (nspace.empty()) {
       return util::format(DO_STR("{}"), name);
@@ -98,36 +139,217 @@ namespace dotother {
   void Assembly::AddCall(const std::string& name, void* fn) {
   }
 
+  AttributeTargets Assembly::GetAttributeTargets(const Type& attribute) const {
+    return {
+      .types = TargetsWithAttribute(attribute, &AttributeBucket::types),
+      .methods = TargetsWithAttribute(attribute, &AttributeBucket::methods),
+      .fields = TargetsWithAttribute(attribute, &AttributeBucket::fields),
+    };
+  }
+
+  template <typename T>
+  std::vector<T*> Assembly::TargetsWithAttribute(const Type& attribute, std::vector<Ordered<T>> AttributeBucket::*kind) const {
+    IndexAttributes();
+
+    std::vector<Ordered<T>> matched;
+    size_t sources = 0;
+    for (const auto& [attr_type, bucket] : attribute_index) {
+      const auto& targets = bucket.*kind;
+      if (targets.empty() || (attr_type->handle != attribute.handle && !attr_type->DerivedFrom(attribute))) {
+        continue;
+      }
+
+      matched.insert(matched.end(), targets.begin(), targets.end());
+      ++sources;
+    }
+
+    /// a target carrying attributes of several matching types is listed once, in declaration order
+    if (sources > 1) {
+      std::ranges::sort(matched, {}, &Ordered<T>::order);
+      auto dupes = std::ranges::unique(matched, {}, &Ordered<T>::target);
+      matched.erase(dupes.begin(), dupes.end());
+    }
+
+    std::vector<T*> res;
+    res.reserve(matched.size());
+    for (const auto& entry : matched) {
+      res.push_back(entry.target);
+    }
+    return res;
+  }
+
+  void Assembly::IndexAttributes() const {
+    std::call_once(attribute_index_once, [this] {
+      uint32_t order = 0;
+      auto add = [&](std::vector<Attribute>& attrs, auto* target, auto kind) {
+        for (auto& attribute : attrs) {
+          Type& attr_type = attribute.GetType();
+          if (attr_type.handle == -1) {
+            continue;
+          }
+
+          /// repeated attributes of one type list their target once
+          auto& targets = attribute_index[&attr_type].*kind;
+          if (targets.empty() || targets.back().target != target) {
+            targets.push_back({ order, target });
+          }
+        }
+        ++order;
+      };
+
+      /// imported members hold their attributes, lazily loaded ones fetch a list for the index alone
+      auto add_member = [&](auto& member, auto kind) {
+        if (member.attributes_loaded) {
+          add(member.attributes, &member, kind);
+        } else {
+          std::vector<Attribute> fetched = member.Attributes();
+          add(fetched, &member, kind);
+        }
+      };
+
+      for (Type* type : types) {
+        if (type == nullptr) {
+          continue;
+        }
+
+        add(type->Attributes(), type, &AttributeBucket::types);
+        for (auto& method : type->Methods()) {
+          add_member(method, &AttributeBucket::methods);
+        }
+        for (auto& field : type->Fields()) {
+          add_member(field, &AttributeBucket::fields);
+        }
+      }
+    });
+  }
+
   ref<Assembly> AssemblyContext::LoadAssembly(const std::string_view path) {
+    ref<Assembly> assembly = nullptr;
+    {
+      StartupProfile::Scope timing(StartupPhase::LOAD_ASSEMBLY);
+      assembly = OpenAssembly(path);
+    }
+
+    if (assembly->asm_id == -1 || assembly->load_status == AssemblyLoadStatus::FILE_LOAD_FAILED) {
+      return nullptr;
+    }
+
+    if (assembly->load_status == AssemblyLoadStatus::SUCCESS) {
+      StartupProfile::Scope timing(StartupPhase::IMPORT_TYPES);
+      TypeCache::Batch batch;
+      ImportTypes(*assembly, batch);
+      TypeCache::Instance().Publish(batch);
+    }
+
+    assemblies.push_back(assembly);
+    return assembly;
+  }
+
+  std::vector<ref<Assembly>> AssemblyContext::LoadAssemblies(std::span<const std::string_view> paths) {
+    std::vector<ref<Assembly>> res(paths.size());
+
+    /// the managed loader and its last load status are not thread safe, files go into the context one at a time
+    {
+      StartupProfile::Scope timing(StartupPhase::LOAD_ASSEMBLY);
+      for (size_t i = 0; i < paths.size(); ++i) {
+        res[i] = OpenAssembly(paths[i]);
+      }
+    }
+
+    /// mapping, exporting and importing metadata only read the runtime and take the cache writer lock per
+    ///   assembly, so the imports run on one worker per core. An exception escaping a jthread would terminate,
+    ///   a failed import is reported as that assembly's status instead
+    TypeCache::Batch batch;
+    std::atomic<size_t> next = 0;
+    std::atomic<bool> failed = false;
+    auto work = [&]() {
+      for (size_t i = next.fetch_add(1); i < res.size(); i = next.fetch_add(1)) {
+        if (res[i]->load_status != AssemblyLoadStatus::SUCCESS) {
+          continue;
+        }
+
+        try {
+          ImportTypes(*res[i], batch);
+          continue;
+        } catch (const std::exception& e) {
+          DOTOTHER_LOG(DO_STR("AssemblyContext::LoadAssemblies({}) => import failed : {}"), MessageLevel::ERR, paths[i], e.what());
+        } catch (...) {
+          DOTOTHER_LOG(DO_STR("AssemblyContext::LoadAssemblies({}) => import failed"), MessageLevel::ERR, paths[i]);
+        }
+        res[i]->load_status = AssemblyLoadStatus::UNKNOWN_ERROR;
+        failed.store(true, std::memory_order_relaxed);
+      }
+    };
+
+    {
+      StartupProfile::Scope timing(StartupPhase::IMPORT_TYPES);
+
+      size_t worker_count = std::min<size_t>(std::max(std::thread::hardware_concurrency(), 1u), res.size());
+      std::vector<std::jthread> workers;
+      workers.reserve(worker_count > 0 ? worker_count - 1 : 0);
+      for (size_t i = 1; i < worker_count; ++i) {
+        workers.emplace_back(work);
+      }
+      work();
+    }
+
+    /// the imports of a batch share the types they stage, a failed one may have left some half filled, so the
+    ///   batch is published whole or not at all. Files that did not open are reported and skipped either way
+    if (failed.load(std::memory_order_relaxed)) {
+      for (size_t i = 0; i < res.size(); ++i) {
+        if (res[i]->load_status == AssemblyLoadStatus::SUCCESS) {
+          DOTOTHER_LOG(DO_STR("AssemblyContext::LoadAssemblies({}) => dropped with its failed batch"), MessageLevel::ERR, paths[i]);
+          res[i]->load_status = AssemblyLoadStatus::UNKNOWN_ERROR;
+        }
+      }
+      return res;
+    }
+
+    TypeCache::Instance().Publish(batch);
+
+    /// the context only sees the batch once every import finished, failed files are reported but not kept
+    for (const auto& assembly : res) {
+      if (assembly->load_status == AssemblyLoadStatus::SUCCESS) {
+        assemblies.push_back(assembly);
+      }
+    }
+
+    return res;
+  }
+
+  ref<Assembly> AssemblyContext::OpenAssembly(const std::string_view path) const {
+    ref<Assembly> assembly = new_ref<Assembly>();
+
     NString filepath = NString::New(path);
     std::filesystem::path p = (std::string)filepath;
 
     if (!std::filesystem::exists(p)) {
       NString::Free(filepath);
       DOTOTHER_LOG(DO_STR("AssemblyContext::LoadAssembly({}) => file does not exist!"), MessageLevel::ERR, path);
-      return nullptr;
+      assembly->load_status = AssemblyLoadStatus::FILE_NOT_FOUND;
+      return assembly;
     } else {
       DOTOTHER_LOG(DO_STR(" > AssemblyContext::LoadAssembly({}) => file exists"), MessageLevel::DEBUG, path);
     }
 
-    size_t idx = assemblies.size();
-    auto& assembly = assemblies.emplace_back(new_ref<Assembly>());
     assembly->asm_id = Interop().load_assembly(context_id, filepath);
+    NString::Free(filepath);
 
     DOTOTHER_LOG(DO_STR(" > Assembly ID: {}"), MessageLevel::DEBUG, assembly->asm_id);
     if (assembly->asm_id == -1) {
-      NString::Free(filepath);
-      assemblies.pop_back();
       DOTOTHER_LOG(DO_STR("Failed to load assembly file: {}"), MessageLevel::ERR, path);
-      return nullptr;
+      /// a loader exception leaves the previous status behind
+      assembly->load_status = Interop().get_last_load_status();
+      if (assembly->load_status == AssemblyLoadStatus::SUCCESS) {
+        assembly->load_status = AssemblyLoadStatus::FILE_LOAD_FAILED;
+      }
+      return assembly;
     }
 
     assembly->load_status = Interop().get_last_load_status();
     if (assembly->load_status == AssemblyLoadStatus::FILE_LOAD_FAILED) {
-      NString::Free(filepath);
-      assemblies.pop_back();
       DOTOTHER_LOG(DO_STR("Failed to load assembly file: {}"), MessageLevel::ERR, path);
-      return nullptr;
+      return assembly;
     }
 
     if (assembly->load_status == AssemblyLoadStatus::SUCCESS) {
@@ -136,34 +358,114 @@ namespace dotother {
       NString::Free(asm_name);
 
       DOTOTHER_LOG(DO_STR(" > Assembly loaded successfully : [{}]"), MessageLevel::INFO, assembly->name);
+    } else {
+      DOTOTHER_LOG(DO_STR("Failed to load assembly file: {} \n\t STATUS : [{}]"), MessageLevel::ERR, path, assembly->load_status);
+    }
+
+    return assembly;
+  }
+
+  void AssemblyContext::ImportTypes(Assembly& assembly, TypeCache::Batch& batch) const {
+    /// one call for every type and member, falls back to walking the types one call at a time
+    if (ImportMetadata(assembly, batch)) {
+      return;
+    }
 
-      int32_t type_counter = 0;
-      Interop().get_asm_types(assembly->asm_id, nullptr, &type_counter);
+    int32_t type_counter = 0;
+    Interop().get_asm_types(assembly.asm_id, nullptr, &type_counter);
 
-      DOTOTHER_LOG(DO_STR(" > Loading [{}] types"), MessageLevel::TRACE, type_counter);
+    DOTOTHER_LOG(DO_STR(" > Loading [{}] types"), MessageLevel::TRACE, type_counter);
 
-      std::vector<int32_t> type_ids(type_counter);
-      Interop().get_asm_types(assembly->asm_id, type_ids.data(), &type_counter);
+    std::vector<int32_t> type_ids(type_counter);
+    Interop().get_asm_types(assembly.asm_id, type_ids.data(), &type_counter);
 
-      for (auto id : type_ids) {
-        DOTOTHER_LOG(DO_STR(" > Loading type with ID: {}"), MessageLevel::TRACE, id);
+    std::vector<TypeCache::PendingType> pending;
+    pending.reserve(type_ids.size());
 
-        Type type(id);
-        Type* t = assembly->types.emplace_back(TypeCache::Instance().CacheType(std::forward<Type>(type)));
-        if (t != nullptr) {
-          //   DOTOTHER_LOG(DO_STR("  > Type loaded: {}"), MessageLevel::TRACE, FormatType(t));
-        } else {
-          DOTOTHER_LOG(DO_STR("  > Type failed to cache : [{}]"), MessageLevel::ERR, id);
+    for (auto id : type_ids) {
+      DOTOTHER_LOG(DO_STR(" > Loading type with ID: {}"), MessageLevel::TRACE, id);
+
+      NString full_name = Interop().get_full_type_name(id);
+      std::string_view name = NString::Intern(full_name);
+
+      pending.push_back({ id, name, util::SplitTypeName(name).first, assembly.asm_id });
+    }
+
+    std::vector<TypeIndex::Entry> index_entries;
+    index_entries.reserve(type_ids.size());
+
+    std::vector<Type*> cached = TypeCache::Instance().CacheTypes(pending, batch);
+    for (size_t i = 0; i < cached.size(); ++i) {
+      Type* t = assembly.types.emplace_back(cached[i]);
+      if (t != nullptr) {
+        //   DOTOTHER_LOG(DO_STR("  > Type loaded: {}"), MessageLevel::TRACE, FormatType(t));
+        index_entries.push_back({ pending[i].full_name, t });
+      } else {
+        DOTOTHER_LOG(DO_STR("  > Type failed to cache : [{}]"), MessageLevel::ERR, pending[i].handle);
+      }
+    }
+
+    assembly.type_index = TypeIndex::Build(index_entries);
+    /// attributes are indexed on the first query, importing does not load any members
+
+    DOTOTHER_LOG(DO_STR(" > Loaded [{}] types"), MessageLevel::TRACE, assembly.types.size());
+  }
+
+  bool AssemblyContext::ImportMetadata(Assembly& assembly, TypeCache::Batch& batch) const {
+    std::filesystem::path cache_file;
+    if (!metadata_cache_dir.empty()) {
+      const metadata::CacheKey key = MetadataImage::Key(assembly.asm_id);
+      cache_file = MetadataCacheFile(metadata_cache_dir, assembly, key);
+
+      /// a cached image skips the export, managed only resolves the type records to the ids of this process and
+      ///   each type's members when they are first used
+      if (ref<MetadataImage> cached = MetadataImage::Map(cache_file); cached != nullptr && cached->Header().key == key) {
+        /// the recorded ids belong to the process that wrote the image, never import without fresh ones
+        ref<ImageBinding> binding = ImageBinding::Bind(cached, assembly.asm_id);
+        if (binding != nullptr && cached->Import(assembly, batch, binding)) {
+          DOTOTHER_LOG(DO_STR(" > Metadata cache hit : [{}]"), MessageLevel::TRACE, cache_file.string());
+          return true;
         }
       }
+    }
 
-      DOTOTHER_LOG(DO_STR(" > Loaded [{}] types"), MessageLevel::TRACE, assembly->types.size());
-    } else {
-      DOTOTHER_LOG(DO_STR("Failed to load assembly file: {} \n\t STATUS : [{}]"), MessageLevel::ERR, path, assembly->load_status);
+    ref<MetadataImage> image = MetadataImage::Export(assembly.asm_id);
+    if (image == nullptr) {
+      return false;
     }
 
-    NString::Free(filepath);
-    return assembly;
+    if (!cache_file.empty()) {
+      image->Save(cache_file);
+    }
+
+    return image->Import(assembly, batch);
+  }
+
+  std::vector<Type*> AssemblyContext::FindTypesWithAttribute(const Type& attribute) const {
+    std::vector<Type*> res;
+    for (const auto& assembly : assemblies) {
+      auto targets = assembly->TargetsWithAttribute(attribute, &Assembly::AttributeBucket::types);
+      res.insert(res.end(), targets.begin(), targets.end());
+    }
+    return res;
+  }
+
+  std::vector<Method*> AssemblyContext::FindMethodsWithAttribute(const Type& attribute) const {
+    std::vector<Method*> res;
+    for (const auto& assembly : assemblies) {
+      auto targets = assembly->TargetsWithAttribute(attribute, &Assembly::AttributeBucket::methods);
+      res.insert(res.end(), targets.begin(), targets.end());
+    }
+    return res;
+  }
+
+  std::vector<Field*> AssemblyContext::FindFieldsWithAttribute(const Type& attribute) const {
+    std::vector<Field*> res;
+    for (const auto& assembly : assemblies) {
+      auto targets = assembly->TargetsWithAttribute(attribute, &Assembly::AttributeBucket::fields);
+      res.insert(res.end(), targets.begin(), targets.end());
+    }
+    return res;
   }
 
   const std::vector<ref<Assembly>>& AssemblyContext::GetAssemblies() const {
@@ -4,8 +4,12 @@
 #ifndef DOTOTHER_NATIVE_ASSEMBLY_HPP
 #define DOTOTHER_NATIVE_ASSEMBLY_HPP
 
+#include <filesystem>
+#include <mutex>
+#include <span>
 #include <string>
 #include <string_view>
+#include <unordered_map>
 #include <vector>
 
 #ifdef DOTOTHER_WINDOWS_DEBUG
@@ -16,6 +20,8 @@
 
 #include "hosting/interop_interface.hpp"
 #include "hosting/type.hpp"
+#include "hosting/type_cache.hpp"
+#include "hosting/type_index.hpp"
 #include "reflection/echo_type.hpp"
 
 
@@ -26,6 +32,13 @@ namespace dotother {
 
   class Host;
 
+  /// everything in one assembly that carries a given attribute, in declaration order
+  struct AttributeTargets {
+    std::vector<Type*> types;
+    std::vector<Method*> methods;
+    std::vector<Field*> fields;
+  };
+
   class Assembly {
    public:
     Assembly() {}
@@ -40,6 +53,16 @@ namespace dotother {
     bool HasType(const std::string_view name, const std::string_view nspace = "") const;
     Type& GetType(const std::string_view klass, const std::string_view nspace = "") const;
     const std::vector<Type*>& GetTypes() const;
+    /// name index over this assembly's types, for prefix and namespace queries
+    const TypeIndex& GetTypeIndex() const;
+
+    /// types, methods and fields carrying attribute or an attribute deriving from it, matched like
+    ///   Type::HasAttribute. Reads an index built from the metadata image at import, an assembly imported without
+    ///   one builds it on the first query. Safe to call from any thread
+    AttributeTargets GetAttributeTargets(const Type& attribute) const;
+
+    /// loads members of known-hot types up front instead of on first use
+    void Prefetch(std::span<const std::string_view> type_names, MemberCategory categories = MemberCategory::ALL) const;
 
     std::string GetAsmQualifiedName(const std::string_view klass, const std::string_view nspace) const;
     std::string GetAsmQualifiedMethodName(const std::string_view klass, const std::string_view method_name, const std::string_view nspace = "") const;
@@ -55,11 +78,35 @@ namespace dotother {
     std::vector<InternalCall> internal_calls = {};
 
     std::vector<Type*> types = {};
+    TypeIndex type_index;
+
+    /// a target and its position in declaration order, matches over several attribute types merge by it
+    template <typename T>
+    struct Ordered {
+      uint32_t order;
+      T* target;
+    };
+
+    struct AttributeBucket {
+      std::vector<Ordered<Type>> types;
+      std::vector<Ordered<Method>> methods;
+      std::vector<Ordered<Field>> fields;
+    };
+
+    /// targets keyed by the attribute type they carry, a query only tests the distinct attribute types
+    mutable std::unordered_map<Type*, AttributeBucket> attribute_index;
+    mutable std::once_flag attribute_index_once;
 
     void AddCall(const std::string& name, void* fn);
+    /// fills attribute_index once, loading the members of every type when they did not come from an image
+    void IndexAttributes() const;
+
+    template <typename T>
+    std::vector<T*> TargetsWithAttribute(const Type& attribute, std::vector<Ordered<T>> AttributeBucket::*kind) const;
 
     friend class Host;
     friend class AssemblyContext;
+    friend class MetadataImage;
 
 #ifdef DOTOTHER_WINDOWS_DEBUG
     friend class DoTest;
@@ -72,12 +119,30 @@ namespace dotother {
     AssemblyContext() {}
 
     ref<Assembly> LoadAssembly(const std::string_view path);
+    /// Loads a batch of files and imports their metadata on one worker per core. Results line up with paths,
+    ///   a file that failed comes back with its LoadStatus and is not added to the context, an import that threw
+    ///   reports UNKNOWN_ERROR. The context lists the batch only once every import has finished.
+    std::vector<ref<Assembly>> LoadAssemblies(std::span<const std::string_view> paths);
     const std::vector<ref<Assembly>>& GetAssemblies() const;
 
+    /// script discovery across every assembly of the context, one index scan per assembly
+    std::vector<Type*> FindTypesWithAttribute(const Type& attribute) const;
+    std::vector<Method*> FindMethodsWithAttribute(const Type& attribute) const;
+    std::vector<Field*> FindFieldsWithAttribute(const Type& attribute) const;
+
     int32_t context_id = -1;
 
    private:
     std::vector<ref<Assembly>> assemblies{};
+    std::filesystem::path metadata_cache_dir;
+
+    /// loads the file into the managed context and fills name and status, asm_id stays -1 when it did not load
+    ref<Assembly> OpenAssembly(const std::string_view path) const;
+    /// stages the types of an opened assembly in batch, safe to run for several assemblies at once. Nothing is
+    ///   visible to lookups until the caller publishes the batch
+    void ImportTypes(Assembly& assembly, TypeCache::Batch& batch) const;
+    bool ImportMetadata(Assembly& assembly, TypeCache::Batch& batch) const;
+
     friend class Host;
   };
 
@@ -1,21 +1,107 @@
 /**
- * \file hosting/attribute.hpp
+ * \file hosting/attribute.cpp
  **/
 #include "hosting/attribute.hpp"
 
+#include <cstring>
+#include <mutex>
+#include <unordered_map>
+
+#include "core/string_pool.hpp"
 #include "core/utilities.hpp"
 
+#include "hosting/interop_interface.hpp"
+#include "hosting/memory.hpp"
 #include "hosting/type.hpp"
 #include "hosting/type_cache.hpp"
 
 namespace dotother {
 
+  namespace {
+
+    /// attribute id => values, nodes never move so every copy of an attribute can keep a pointer into it
+    struct SnapshotCache {
+      std::mutex mutex;
+      std::unordered_map<int32_t, std::vector<AttributeValue>> values;
+    };
+
+    SnapshotCache& Snapshots() {
+      static SnapshotCache cache;
+      return cache;
+    }
+
+  }  // namespace
+
+  std::vector<AttributeValue> Attribute::ReadSnapshot(std::span<const std::byte> snapshot) {
+    using namespace attribute_snapshot;
+
+    const std::byte* block = snapshot.data();
+    size_t size = snapshot.size();
+
+    Header header;
+    if (size < sizeof(header)) {
+      return {};
+    }
+    std::memcpy(&header, block, sizeof(header));
+
+    if (header.size != size || header.strings > size ||
+        sizeof(header) + static_cast<uint64_t>(header.count) * sizeof(Record) > header.strings) {
+      DOTOTHER_LOG(DO_STR("Attribute::ReadSnapshot: malformed snapshot of [{}] bytes"), MessageLevel::ERR, size);
+      return {};
+    }
+
+    std::span<const std::byte> strings(block + header.strings, size - header.strings);
+    auto string_at = [&](uint32_t offset) -> std::string_view {
+      uint32_t length = 0;
+      if (static_cast<uint64_t>(offset) + sizeof(length) > strings.size()) {
+        return {};
+      }
+      std::memcpy(&length, strings.data() + offset, sizeof(length));
+      if (static_cast<uint64_t>(offset) + sizeof(length) + length > strings.size()) {
+        return {};
+      }
+      std::string_view str(reinterpret_cast<const char*>(strings.data() + offset + sizeof(length)), length);
+      return StringPool::Instance().Intern(str);
+    };
+
+    std::vector<AttributeValue> values;
+    values.reserve(header.count);
+    for (uint32_t i = 0; i < header.count; ++i) {
+      Record record;
+      std::memcpy(&record, block + sizeof(header) + i * sizeof(record), sizeof(record));
+
+      AttributeValue& value = values.emplace_back();
+      value.name = string_at(record.name);
+      value.kind = static_cast<ManagedType>(record.kind);
+      if (value.kind == ManagedType::STRING) {
+        value.string = string_at(static_cast<uint32_t>(record.value));
+      } else {
+        value.bits = record.value;
+      }
+    }
+
+    return values;
+  }
+
+  void Attribute::EvictSnapshots(std::span<const int32_t> ids) {
+    auto& cache = Snapshots();
+    std::scoped_lock lock(cache.mutex);
+    for (int32_t id : ids) {
+      cache.values.erase(id);
+    }
+  }
+
   Attribute::Attribute(uint32_t hash) {
     handle = hash;
   }
 
   Type& Attribute::GetType() {
-    Type* type = TypeCache::Instance().CacheType(Type(handle));
+    if (type == nullptr) {
+      Type attr_type;
+      Interop().get_attr_type(handle, &attr_type.handle);
+      type = TypeCache::Instance().CacheType(std::forward<Type>(attr_type));
+    }
+
     if (type == nullptr) {
       DOTOTHER_LOG(DO_STR("Attribute::GetType: Failed to cache attribute type"), MessageLevel::ERR);
       static Type null_type(-1);
@@ -24,4 +110,31 @@ namespace dotother {
     return *type;
   }
 
-}  // namespace dotother
\ No newline at end of file
+  const std::vector<AttributeValue>& Attribute::Values() {
+    if (values != nullptr) {
+      return *values;
+    }
+
+    auto& cache = Snapshots();
+    std::scoped_lock lock(cache.mutex);
+    if (auto itr = cache.values.find(handle); itr != cache.values.end()) {
+      values = &itr->second;
+      return *values;
+    }
+
+    void* block = nullptr;
+    int32_t size = 0;
+    Interop().get_attr_snapshot(handle, &block, &size);
+
+    std::vector<AttributeValue> snapshot;
+    if (block != nullptr) {
+      snapshot = ReadSnapshot(std::span(static_cast<const std::byte*>(block), static_cast<size_t>(size)));
+      Memory::FreeHGlobal(block);
+    }
+
+    /// a failed read is cached too, asking again would fail the same way
+    values = &cache.values.emplace(handle, std::move(snapshot)).first->second;
+    return *values;
+  }
+
+}  // namespace dotother
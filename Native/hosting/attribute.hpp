@@ -4,20 +4,113 @@
 #ifndef DOTOTHER_ATTRIBUTE_HPP
 #define DOTOTHER_ATTRIBUTE_HPP
 
+#include <bit>
 #include <cstdint>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include "core/dotother_defines.hpp"
+#include "core/utilities.hpp"
 
 namespace dotother {
 
   class Type;
 
+  namespace attribute_snapshot {
+
+    /// layout shared with DotOther.Managed.AttributeSnapshot
+#pragma pack(push, 1)
+    struct Header {
+      uint32_t size;
+      uint32_t count;
+      uint32_t strings;
+      uint32_t reserved;
+    };
+
+    struct Record {
+      uint32_t name;
+      int32_t kind;
+      uint64_t value;
+    };
+#pragma pack(pop)
+
+    static_assert(sizeof(Header) == 16, "Invalid size for attribute_snapshot::Header!");
+    static_assert(sizeof(Record) == 16, "Invalid size for attribute_snapshot::Record!");
+
+  }  // namespace attribute_snapshot
+
+  /// one primitive or string field of an attribute instance, see Attribute::Values
+  struct AttributeValue {
+    /// field name, auto-property backing fields carry the property name. Interned, see StringPool
+    std::string_view name;
+    ManagedType kind = ManagedType::UNKNOWN;
+    /// integers widened to 64 bits, floats as their IEEE bits
+    uint64_t bits = 0;
+    /// interned, set for STRING values
+    std::string_view string;
+
+    /// std::nullopt unless T matches the field's managed type, enums convert from their underlying type
+    template <typename T>
+    std::optional<T> As() const {
+      if constexpr (std::same_as<T, std::string_view>) {
+        return kind == ManagedType::STRING ? std::optional<T>(string) : std::nullopt;
+      } else if constexpr (std::is_arithmetic_v<T> || std::is_enum_v<T>) {
+        if (util::GetManagedType<T>() != kind) {
+          return std::nullopt;
+        }
+
+        if constexpr (std::same_as<T, bool>) {
+          return bits != 0;
+        } else if constexpr (std::same_as<T, float>) {
+          return std::bit_cast<float>(static_cast<uint32_t>(bits));
+        } else if constexpr (std::same_as<T, double>) {
+          return std::bit_cast<double>(bits);
+        } else {
+          return static_cast<T>(bits);
+        }
+      } else {
+        static_assert(!sizeof(T), "AttributeValue::As: unsupported type");
+      }
+    }
+  };
+
   class Attribute {
    public:
     Attribute(uint32_t handle);
 
     Type& GetType();
 
+    /// every primitive and string field of the instance. Read in one call the first time any copy of this
+    ///   attribute asks and cached for the life of the host, attributes are immutable
+    const std::vector<AttributeValue>& Values();
+
+    template <typename T>
+    std::optional<T> GetValue(std::string_view name) {
+      for (const auto& value : Values()) {
+        if (value.name == name) {
+          return value.As<T>();
+        }
+      }
+      return std::nullopt;
+    }
+
+    /// values of a block written by DotOther.Managed.AttributeSnapshot, empty when it is malformed
+    static std::vector<AttributeValue> ReadSnapshot(std::span<const std::byte> block);
+
+    /// drops the cached values of attributes whose load context unloaded, copies of those attributes must not
+    ///   be asked for Values afterwards. Called when the TypeCache evicts their types
+    static void EvictSnapshots(std::span<const int32_t> ids);
+
    private:
     int32_t handle;
+    Type* type = nullptr;
+    const std::vector<AttributeValue>* values = nullptr;
+
+    friend class MetadataImage;
+    friend class TypeCache;
   };
 
 }  // namespace dotother
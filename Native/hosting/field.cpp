@@ -14,8 +14,13 @@ namespace dotother {
     this->handle = handle;
   }
 
-  NString Field::GetName() const {
-    return Interop().get_field_name(handle);
+  std::string_view Field::GetName() const {
+    return name;
+  }
+
+  void Field::LoadName() {
+    NString managed_name = Interop().get_field_name(handle);
+    name = NString::Intern(managed_name);
   }
 
   Type& Field::GetType() {
@@ -38,6 +43,10 @@ namespace dotother {
   }
 
   std::vector<Attribute> Field::Attributes() const {
+    if (attributes_loaded) {
+      return attributes;
+    }
+
     int32_t count = 0;
     Interop().get_field_attributes(handle, nullptr, &count);
 
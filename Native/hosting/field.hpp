@@ -4,25 +4,27 @@
 #ifndef DOTOTHER_FIELD_HPP
 #define DOTOTHER_FIELD_HPP
 
+#include <string>
 #include <string_view>
 #include <vector>
 
 #include "core/dotother_defines.hpp"
 #include "core/utilities.hpp"
 
+#include "hosting/attribute.hpp"
 #include "hosting/native_string.hpp"
 
 namespace dotother {
 
   class Type;
-  class Attribute;
 
   class Field {
    public:
     Field(uint32_t handle);
     ~Field() = default;
 
-    NString GetName() const;
+    /// filled when the owning type loads its members, see Type::LoadMembers
+    std::string_view GetName() const;
     Type& GetType();
 
     TypeAccessibility Accessibility() const;
@@ -31,9 +33,18 @@ namespace dotother {
 
    private:
     int32_t handle = -1;
+    std::string_view name;
     Type* type = nullptr;
 
+    std::vector<Attribute> attributes;
+    bool attributes_loaded = false;
+
+    void LoadName();
+
     friend class Type;
+    friend class Assembly;
+    friend class MetadataImage;
+    friend class TypeCache;
   };
 
 }  // namespace dotother
@@ -3,16 +3,18 @@
  */
 #include "hosting/host.hpp"
 
-#include <array>
 #include <cassert>
 #include <cstdint>
+#include <cstdlib>
 #include <filesystem>
 #include <iostream>
 #include <optional>
 #include <ostream>
+#include <span>
 #include <stdexcept>
 #include <string>
 #include <string_view>
+#include <vector>
 
 #include <spdlog/fmt/fmt.h>
 
@@ -20,8 +22,11 @@
 #include "core/utilities.hpp"
 
 #include "hosting/assembly.hpp"
+#include "hosting/hostfxr_resolver.hpp"
 #include "hosting/interop_interface.hpp"
+#include "hosting/memory.hpp"
 #include "hosting/native_string.hpp"
+#include "hosting/type_cache.hpp"
 
 using namespace dotother::literals;
 
@@ -29,6 +34,7 @@ namespace dotother {
 
   struct CoreClrFunctions {
     hostfxr_set_error_writer_fn set_error_writer = nullptr;
+    hostfxr_set_runtime_property_value_fn set_runtime_property = nullptr;
     hostfxr_initialize_for_dotnet_command_line_fn init_host_cmd_line = nullptr;
     hostfxr_initialize_for_runtime_config_fn init_host_config = nullptr;
     hostfxr_get_runtime_delegate_fn get_runtime_delegate = nullptr;
@@ -37,6 +43,62 @@ namespace dotother {
   };
   static CoreClrFunctions coreclr;
 
+  namespace {
+
+    /// sets process environment variables and puts the previous values back when destroyed, for knobs the
+    ///   runtime only reads while it starts
+    class ScopedEnvironment {
+     public:
+      ScopedEnvironment() = default;
+      ~ScopedEnvironment() {
+        for (auto itr = saved.rbegin(); itr != saved.rend(); ++itr) {
+          Write(itr->name.c_str(), itr->value);
+        }
+      }
+
+      ScopedEnvironment(const ScopedEnvironment&) = delete;
+      ScopedEnvironment& operator=(const ScopedEnvironment&) = delete;
+
+      void Set(const char* name, const std::string& value) {
+        const char* previous = std::getenv(name);
+        saved.push_back({ name, previous != nullptr ? std::optional<std::string>(previous) : std::nullopt });
+        Write(name, value);
+      }
+
+     private:
+      struct Saved {
+        std::string name;
+        std::optional<std::string> value;
+      };
+
+      std::vector<Saved> saved;
+
+      static void Write(const char* name, const std::optional<std::string>& value) {
+#ifdef DOTOTHER_WINDOWS
+        /// an empty value removes the variable
+        _putenv_s(name, value.has_value() ? value->c_str() : "");
+#else
+        if (value.has_value()) {
+          setenv(name, value->c_str(), 1);
+        } else {
+          unsetenv(name);
+        }
+#endif  // DOTOTHER_WINDOWS
+      }
+    };
+
+    /// config knobs without a runtime property are read from the environment when the runtime starts
+    void ApplyRuntimeEnvironment(const RuntimeOptions& options, ScopedEnvironment& env) {
+      if (options.ready_to_run.has_value()) {
+        env.Set("DOTNET_ReadyToRun", *options.ready_to_run ? "1" : "0");
+      }
+      if (options.tiered_call_count_threshold.has_value()) {
+        env.Set("DOTNET_TC_CallCountThreshold", std::to_string(*options.tiered_call_count_threshold));
+      }
+    }
+
+  }  // namespace
+
   template <typename Fn>
   Fn LoadFunction(void* handle, const char* name) {
 #ifdef _WIN32
@@ -98,6 +160,17 @@ namespace dotother {
       return false;
     }
 
+    /// every managed function is loaded from managed_asm_path, swapping it picks the precompiled build everywhere
+    if (!config->managed_r2r_asm_path.empty() && config->runtime.ready_to_run.value_or(true)) {
+      if (std::filesystem::exists(config->managed_r2r_asm_path)) {
+        config->managed_asm_path = config->managed_r2r_asm_path;
+        DOTOTHER_LOG(DO_STR("Using ReadyToRun managed assembly : {}"), MessageLevel::DEBUG, config->managed_asm_path.string());
+      } else {
+        DOTOTHER_LOG(DO_STR("ReadyToRun managed assembly not found, falling back to {}"), MessageLevel::WARNING,
+                     config->managed_asm_path.string());
+      }
+    }
+
     if (!std::filesystem::exists(config->managed_asm_path)) {
       DOTOTHER_LOG(DO_STR("Managed assembly path does not exist"), MessageLevel::CRITICAL);
       return false;
@@ -127,7 +200,10 @@ namespace dotother {
       };
     }
 
-    is_loaded = InitializeHost();
+    {
+      StartupProfile::Scope timing(StartupPhase::INITIALIZE_HOST);
+      is_loaded = InitializeHost();
+    }
     if (!is_loaded) {
       DOTOTHER_LOG(DO_STR("Failed to initialize host, unloading..."), MessageLevel::CRITICAL);
       UnloadHost();
@@ -153,7 +229,10 @@ namespace dotother {
       throw std::runtime_error("Entry point is null");
     }
 
-    LoadManagedFunctions();
+    {
+      StartupProfile::Scope timing(StartupPhase::MANAGED_FUNCTIONS);
+      LoadManagedFunctions();
+    }
 
     DotOtherArgs args = {
       .exception_callback = config->exception_callback,
@@ -163,6 +242,8 @@ namespace dotother {
         return InteropInterface::Instance().GetRegisteredObject(handle);
       },
     };
+
+    StartupProfile::Scope timing(StartupPhase::ENTRY_POINT);
     host_calls.entry(args);
   }
 
@@ -193,6 +274,7 @@ namespace dotother {
     coreclr.get_runtime_delegate = nullptr;
     coreclr.close_host_fxr = nullptr;
     coreclr.set_error_writer = nullptr;
+    coreclr.set_runtime_property = nullptr;
     coreclr.get_managed_function_ptr = nullptr;
   }
 
@@ -205,6 +287,7 @@ namespace dotother {
     NScopedString ctx_name = NString::New(name);
     AssemblyContext ctx;
     ctx.context_id = Interop().create_assembly_load_context(ctx_name);
+    ctx.metadata_cache_dir = config->metadata_cache_path;
 
     return ctx;
   }
@@ -217,7 +300,15 @@ namespace dotother {
     Interop().collect_garbage(0, dotother::GCMode::DEFAULT, true, true);
     Interop().wait_for_pending_finalizers();
 
-    Interop().unload_assembly_load_context(load_context.context_id);
+    /// managed only drops this context's ids, the cache forgets the same types so other contexts keep theirs
+    int32_t* evicted = nullptr;
+    int32_t evicted_count = 0;
+    Interop().unload_assembly_load_context(load_context.context_id, &evicted, &evicted_count);
+    if (evicted != nullptr) {
+      TypeCache::Instance().Evict(std::span<const int32_t>(evicted, static_cast<size_t>(evicted_count)));
+      Memory::FreeHGlobal(evicted);
+    }
+
     load_context.context_id = -1;
     load_context.assemblies.clear();
   }
@@ -226,62 +317,38 @@ namespace dotother {
     return InteropInterface::Instance().FunctionTable();
   }
 
-  namespace {
-
-    std::optional<std::filesystem::path> GetHostPath() {
-#ifdef DOTOTHER_WINDOWS
-      std::filesystem::path base_path = "";
-
-      TCHAR buffer[MAX_PATH];
-      SHGetSpecialFolderPath(nullptr, buffer, CSIDL_PROGRAM_FILES, FALSE);
+  StartupReport Host::GetStartupReport(bool include_managed) const {
+    StartupReport report = StartupProfile::Instance().Report();
 
-      base_path = buffer;
-      base_path /= "dotnet/host/fxr";
-      auto search_paths = std::array{
-        base_path
-      };
-#else
-      auto search_paths = std::array{
-        std::filesystem::path("/usr/lib/dotnet/host/fxr"),
-        std::filesystem::path("/usr/local/share/dotnet/host/fxr")
-      };
-#endif  // !DOTOTHER_WINDOWS
-      for (const auto& path : search_paths) {
-        if (!std::filesystem::exists(path)) {
-          continue;
-        }
-
-        for (const auto& dir : std::filesystem::recursive_directory_iterator(path)) {
-          if (!dir.is_directory()) {
-            continue;
-          }
-
-          auto dp = dir.path();
-          if (dp.string().find(DOTOTHER_DOTNET_TARGET_VERSION_MAJOR_STR) == std::string::npos) {
-            continue;
-          }
-
-          auto res = dp / DOTOTHER_HOSTFXR_NAME;
-          if (!std::filesystem::exists(res)) {
-            return std::nullopt;
-          }
-
-          return res;
-        }
-      }
-
-      return std::nullopt;
+    /// read straight from the table, the report should not count the call it makes
+    auto& interop = InteropInterface::Instance().FunctionTable();
+    if (include_managed && interop.BoundToAsm()) {
+      interop.get_startup_timings(reinterpret_cast<int64_t*>(report.managed_ns.data()), static_cast<int32_t>(report.managed_ns.size()));
+      report.has_managed = true;
     }
 
-  }  // anonymous namespace
+    return report;
+  }
 
   bool Host::LoadClrFunctions() {
-    std::optional<std::filesystem::path> host_path = GetHostPath();
+    std::optional<std::filesystem::path> host_path;
+    {
+      StartupProfile::Scope timing(StartupPhase::HOST_PATH);
+      host_path = ResolveHostFxr(HostFxrSearch{
+        .hostfxr_path = config->hostfxr_path,
+        .dotnet_root = config->dotnet_root,
+        .app_path = config->managed_asm_path,
+      });
+    }
+
     if (!host_path.has_value()) {
       DOTOTHER_LOG(DO_STR("Failed to get host path"), MessageLevel::CRITICAL);
       return false;
     }
 
+    /// loading hostfxr and its exports, the path search above is its own phase
+    StartupProfile::Scope timing(StartupPhase::CLR_FUNCTIONS);
+
 #ifdef DOTOTHER_WINDOWS
     void* hostfxr_lib = LoadLibraryW(host_path->c_str());
     if (hostfxr_lib == nullptr) {
@@ -302,6 +369,7 @@ namespace dotother {
     // coreclr.run_app = LoadFunction<hostfxr_run_app_fn>(hostfxr_lib, "hostfxr_run_app");
     coreclr.close_host_fxr = LoadFunction<hostfxr_close_fn>(hostfxr_lib, "hostfxr_close");
     coreclr.set_error_writer = LoadFunction<hostfxr_set_error_writer_fn>(hostfxr_lib, "hostfxr_set_error_writer");
+    coreclr.set_runtime_property = LoadFunction<hostfxr_set_runtime_property_value_fn>(hostfxr_lib, "hostfxr_set_runtime_property_value");
 
     if (coreclr.init_host_cmd_line == nullptr || coreclr.init_host_config == nullptr ||
         coreclr.get_runtime_delegate == nullptr || coreclr.close_host_fxr == nullptr) {
@@ -323,8 +391,19 @@ namespace dotother {
       return false;
     }
 
+    /// properties only take effect before the runtime loads, which get_runtime_delegate does
+    if (!ApplyRuntimeOptions(host_fxr)) {
+      coreclr.close_host_fxr(host_fxr);
+      return false;
+    }
+
     void* delegate = nullptr;
-    rc = coreclr.get_runtime_delegate(host_fxr, hdt_load_assembly_and_get_function_pointer, &delegate);
+    {
+      /// the runtime reads the environment knobs while it starts, the caller's environment is restored after
+      ScopedEnvironment env;
+      ApplyRuntimeEnvironment(config->runtime, env);
+      rc = coreclr.get_runtime_delegate(host_fxr, hdt_load_assembly_and_get_function_pointer, &delegate);
+    }
     if (rc != 0 || delegate == nullptr) {
       DOTOTHER_LOG(DO_STR("Could not get managed function pointer : {:#08x}"), MessageLevel::CRITICAL, rc);
       coreclr.close_host_fxr(host_fxr);
@@ -348,71 +427,44 @@ namespace dotother {
     return true;
   }
 
+  bool Host::ApplyRuntimeOptions(hostfxr_handle context) {
+    const RuntimeOptions& options = config->runtime;
+
+    auto set_property = [&](const dochar* name, std::optional<bool> value) {
+      if (!value.has_value()) {
+        return true;
+      }
+
+      if (coreclr.set_runtime_property == nullptr) {
+        DOTOTHER_LOG(DO_STR("hostfxr_set_runtime_property_value unavailable, can not apply runtime options"), MessageLevel::ERR);
+        return false;
+      }
+
+      int32_t rc = coreclr.set_runtime_property(context, name, *value ? DO_STR("true") : DO_STR("false"));
+      if (rc != 0) {
+        DOTOTHER_LOG(DO_STR("Could not set runtime property : {:#08x}"), MessageLevel::ERR, rc);
+        return false;
+      }
+      return true;
+    };
+
+    /// the environment knobs are set around get_runtime_delegate, see ApplyRuntimeEnvironment
+    return set_property(DO_STR("System.Runtime.TieredCompilation"), options.tiered_compilation) &&
+           set_property(DO_STR("System.Runtime.TieredPGO"), options.tiered_pgo) &&
+           set_property(DO_STR("System.Runtime.TieredCompilation.QuickJitForLoops"), options.quick_jit_for_loops);
+  }
+
   void Host::LoadManagedFunctions() {
     auto& interop = Interop();
-    interop.create_assembly_load_context = LoadManagedFunction<CreateAssemblyLoadContext>(DO_STR("DotOther.Managed.AssemblyLoader, DotOther.Managed"), DO_STR("CreateAssemblyLoadContext"));
-    interop.unload_assembly_load_context = LoadManagedFunction<UnloadAssemblyLoadContext>(DO_STR("DotOther.Managed.AssemblyLoader, DotOther.Managed"), DO_STR("UnloadAssemblyLoadContext"));
-    interop.get_last_load_status = LoadManagedFunction<GetLastLoadStatus>(DO_STR("DotOther.Managed.AssemblyLoader, DotOther.Managed"), DO_STR("GetLastLoadStatus"));
-    interop.load_assembly = LoadManagedFunction<LoadAssembly>(DO_STR("DotOther.Managed.AssemblyLoader, DotOther.Managed"), DO_STR("LoadAssembly"));
-    interop.get_assembly_name = LoadManagedFunction<GetAssemblyName>(DO_STR("DotOther.Managed.AssemblyLoader, DotOther.Managed"), DO_STR("GetAsmName"));
-
-    interop.get_net_core_types = LoadManagedFunction<GetNetCoreTypes>(DO_STR("DotOther.Managed.InteropInterface, DotOther.Managed"), DO_STR("GetNetCoreTypes"));
-    interop.get_asm_types = LoadManagedFunction<GetAsmTypes>(DO_STR("DotOther.Managed.InteropInterface, DotOther.Managed"), DO_STR("GetAsmTypes"));
-    interop.get_type_id = LoadManagedFunction<GetTypeId>(DO_STR("DotOther.Managed.InteropInterface, DotOther.Managed"), DO_STR("GetTypeId"));
-    interop.get_full_type_name = LoadManagedFunction<GetFullTypeName>(DO_STR("DotOther.Managed.InteropInterface, DotOther.Managed"), DO_STR("GetFullTypeName"));
-    interop.get_asm_qualified_name = LoadManagedFunction<GetAsmQualifiedName>(DO_STR("DotOther.Managed.InteropInterface, DotOther.Managed"), DO_STR("GetAsmQualifiedName"));
-    interop.get_base_type = LoadManagedFunction<GetBaseType>(DO_STR("DotOther.Managed.InteropInterface, DotOther.Managed"), DO_STR("GetBaseType"));
-    interop.get_type_size = LoadManagedFunction<GetTypeSize>(DO_STR("DotOther.Managed.InteropInterface, DotOther.Managed"), DO_STR("GetTypeSize"));
-    interop.is_type_derived_from = LoadManagedFunction<IsTypeDerivedFrom>(DO_STR("DotOther.Managed.InteropInterface, DotOther.Managed"), DO_STR("IsTypeDerivedFrom"));
-    interop.is_assignable_to = LoadManagedFunction<IsAssignableTo>(DO_STR("DotOther.Managed.InteropInterface, DotOther.Managed"), DO_STR("IsAssignableTo"));
-    interop.is_assignable_from = LoadManagedFunction<IsAssignableFrom>(DO_STR("DotOther.Managed.InteropInterface, DotOther.Managed"), DO_STR("IsAssignableFrom"));
-    interop.is_type_sz_array = LoadManagedFunction<IsTypeSZArray>(DO_STR("DotOther.Managed.InteropInterface, DotOther.Managed"), DO_STR("IsSzArray"));
-    interop.get_element_type = LoadManagedFunction<GetElementType>(DO_STR("DotOther.Managed.InteropInterface, DotOther.Managed"), DO_STR("GetElementType"));
-    interop.get_type_methods = LoadManagedFunction<GetTypeMethods>(DO_STR("DotOther.Managed.InteropInterface, DotOther.Managed"), DO_STR("GetTypeMethods"));
-    interop.get_type_fields = LoadManagedFunction<GetTypeFields>(DO_STR("DotOther.Managed.InteropInterface, DotOther.Managed"), DO_STR("GetTypeFields"));
-    interop.get_type_properties = LoadManagedFunction<GetTypeProperties>(DO_STR("DotOther.Managed.InteropInterface, DotOther.Managed"), DO_STR("GetTypeProperties"));
-    interop.has_type_attribute = LoadManagedFunction<HasTypeAttribute>(DO_STR("DotOther.Managed.InteropInterface, DotOther.Managed"), DO_STR("HasAttribute"));
-    interop.get_type_attributes = LoadManagedFunction<GetTypeAttributes>(DO_STR("DotOther.Managed.InteropInterface, DotOther.Managed"), DO_STR("GetAttributes"));
-    interop.get_type_managed_type = LoadManagedFunction<GetTypeManagedType>(DO_STR("DotOther.Managed.InteropInterface, DotOther.Managed"), DO_STR("GetTypeManagedType"));
-
-    interop.get_field_name = LoadManagedFunction<GetFieldName>(DO_STR("DotOther.Managed.InteropInterface, DotOther.Managed"), DO_STR("GetFieldName"));
-    interop.get_field_type = LoadManagedFunction<GetFieldType>(DO_STR("DotOther.Managed.InteropInterface, DotOther.Managed"), DO_STR("GetFieldType"));
-    interop.get_field_accessibility = LoadManagedFunction<GetFieldAccessibility>(DO_STR("DotOther.Managed.InteropInterface, DotOther.Managed"), DO_STR("GetFieldAccessibility"));
-    interop.get_field_attributes = LoadManagedFunction<GetFieldAttributes>(DO_STR("DotOther.Managed.InteropInterface, DotOther.Managed"), DO_STR("GetFieldAttributes"));
-
-    interop.get_property_name = LoadManagedFunction<GetPropertyName>(DO_STR("DotOther.Managed.InteropInterface, DotOther.Managed"), DO_STR("GetPropertyName"));
-    interop.get_property_type = LoadManagedFunction<GetPropertyType>(DO_STR("DotOther.Managed.InteropInterface, DotOther.Managed"), DO_STR("GetPropertyType"));
-    interop.get_property_attributes = LoadManagedFunction<GetPropertyAttributes>(DO_STR("DotOther.Managed.InteropInterface, DotOther.Managed"), DO_STR("GetPropertyAttributes"));
-
-    interop.get_attr_value = LoadManagedFunction<GetAttributeValue>(DO_STR("DotOther.Managed.InteropInterface, DotOther.Managed"), DO_STR("GetAttributeValue"));
-    interop.get_attr_type = LoadManagedFunction<GetAttributeType>(DO_STR("DotOther.Managed.InteropInterface, DotOther.Managed"), DO_STR("GetAttributeType"));
-
-    interop.get_method_name = LoadManagedFunction<GetMethodName>(DO_STR("DotOther.Managed.InteropInterface, DotOther.Managed"), DO_STR("GetMethodName"));
-    interop.get_method_return_type = LoadManagedFunction<GetMethodReturnType>(DO_STR("DotOther.Managed.InteropInterface, DotOther.Managed"), DO_STR("GetMethodReturnType"));
-    interop.get_method_param_types = LoadManagedFunction<GetMethodParameterTypes>(DO_STR("DotOther.Managed.InteropInterface, DotOther.Managed"), DO_STR("GetMethodParameterTypes"));
-    interop.get_method_attributes = LoadManagedFunction<GetMethodAttributes>(DO_STR("DotOther.Managed.InteropInterface, DotOther.Managed"), DO_STR("GetMethodAttributes"));
-    interop.get_method_accessibility = LoadManagedFunction<GetMethodAccessibility>(DO_STR("DotOther.Managed.InteropInterface, DotOther.Managed"), DO_STR("GetMethodAccessibility"));
-
-    interop.set_internal_calls = LoadManagedFunction<SetInternalCalls>(DO_STR("DotOther.Managed.Interop.InternalCallManager, DotOther.Managed"), DO_STR("SetInternalCalls"));
-    interop.set_internal_call = LoadManagedFunction<SetInternalCall>(DO_STR("DotOther.Managed.Interop.InternalCallManager, DotOther.Managed"), DO_STR("SetInternalCall"));
-
-    interop.create_object = LoadManagedFunction<CreateObject>(DO_STR("DotOther.Managed.ManagedObject, DotOther.Managed"), DO_STR("CreateObject"));
-    interop.destroy_object = LoadManagedFunction<DestroyObject>(DO_STR("DotOther.Managed.ManagedObject, DotOther.Managed"), DO_STR("DestroyObject"));
-
-    interop.invoke_method = LoadManagedFunction<InvokeMethod>(DO_STR("DotOther.Managed.ManagedObject, DotOther.Managed"), DO_STR("InvokeMethod"));
-    interop.invoke_method_ret = LoadManagedFunction<InvokeMethodRet>(DO_STR("DotOther.Managed.ManagedObject, DotOther.Managed"), DO_STR("InvokeMethodRet"));
-
-    interop.invoke_static_method = LoadManagedFunction<InvokeStaticMethod>(DO_STR("DotOther.Managed.ManagedObject, DotOther.Managed"), DO_STR("InvokeStaticMethod"));
-    interop.invoke_static_method_ret = LoadManagedFunction<InvokeStaticMethodRet>(DO_STR("DotOther.Managed.ManagedObject, DotOther.Managed"), DO_STR("InvokeStaticMethodRet"));
-
-    interop.set_field = LoadManagedFunction<SetField>(DO_STR("DotOther.Managed.ManagedObject, DotOther.Managed"), DO_STR("SetField"));
-    interop.get_field = LoadManagedFunction<GetField>(DO_STR("DotOther.Managed.ManagedObject, DotOther.Managed"), DO_STR("GetField"));
-
-    interop.set_property = LoadManagedFunction<SetProperty>(DO_STR("DotOther.Managed.ManagedObject, DotOther.Managed"), DO_STR("SetProperty"));
-    interop.get_property = LoadManagedFunction<GetProperty>(DO_STR("DotOther.Managed.ManagedObject, DotOther.Managed"), DO_STR("GetProperty"));
-
-    interop.collect_garbage = LoadManagedFunction<CollectGarbage>(DO_STR("DotOther.Managed.GarbageCollector, DotOther.Managed"), DO_STR("CollectGarbage"));
-    interop.wait_for_pending_finalizers = LoadManagedFunction<WaitForPendingFinalizers>(DO_STR("DotOther.Managed.GarbageCollector, DotOther.Managed"), DO_STR("WaitForPendingFinalizers"));
+
+    /// one hostfxr lookup for the bootstrap, it writes every other entry of the table itself after checking each
+    ///   slot's tag against the entry it is about to write
+    interop.StampEntries();
+    auto bootstrap = LoadManagedFunction<BootstrapInterop>(DO_STR("DotOther.Managed.InteropBootstrap, DotOther.Managed"), DO_STR("FillFunctionTable"));
+    if (bootstrap == nullptr || !bootstrap(&interop)) {
+      DOTOTHER_LOG(DO_STR("Failed to bootstrap interop function table v{} ({} bytes)"), MessageLevel::CRITICAL,
+                   interface_bindings::kFunctionTableVersion, sizeof(interface_bindings::FunctionTable));
+    }
 
     if (!interop.BoundToAsm()) {
       DOTOTHER_LOG(DO_STR("Failed to load managed functions, runtime not bound to assembly"), MessageLevel::CRITICAL);
@@ -4,6 +4,7 @@
 #ifndef DOTOTHER_NATIVE_HOST_HPP
 #define DOTOTHER_NATIVE_HOST_HPP
 
+#include <cstdint>
 #include <filesystem>
 #include <optional>
 #include <string_view>
@@ -15,6 +16,7 @@
 
 #include "hosting/interop_interface.hpp"
 #include "hosting/assembly.hpp"
+#include "hosting/startup_profile.hpp"
 
 namespace dotother {
   
@@ -27,6 +29,23 @@ namespace dotother {
 
   using EntryPoint = void(DOTOTHER_CALLTYPE*)(DotOtherArgs args);
 
+  /// JIT and tiering knobs applied to the runtime before it starts, unset ones keep the runtimeconfig.json value.
+  ///   The environment backed knobs are set process-wide only while the runtime starts inside LoadHost, the
+  ///   previous values are restored afterwards. Another thread reading those variables meanwhile sees the override
+  struct RuntimeOptions {
+    /// System.Runtime.TieredCompilation, false jits everything fully optimized up front
+    std::optional<bool> tiered_compilation;
+    /// System.Runtime.TieredPGO
+    std::optional<bool> tiered_pgo;
+    /// System.Runtime.TieredCompilation.QuickJitForLoops, false sends methods with loops straight to tier 1
+    std::optional<bool> quick_jit_for_loops;
+    /// DOTNET_ReadyToRun, false ignores precompiled code. There is no runtime property for it, the host sets the
+    ///   environment variable while the runtime starts
+    std::optional<bool> ready_to_run;
+    /// DOTNET_TC_CallCountThreshold, calls before a tier 0 method is promoted. Set through the environment as well
+    std::optional<uint32_t> tiered_call_count_threshold;
+  };
+
   struct HostConfig {
     std::filesystem::path host_config_path;
     std::filesystem::path managed_asm_path;
@@ -37,6 +56,19 @@ namespace dotother {
 
     bool is_verbose = false;
 
+    /// hostfxr library to load, discovered when empty, see ResolveHostFxr
+    std::filesystem::path hostfxr_path;
+    /// dotnet installation searched before DOTNET_ROOT and the default locations
+    std::filesystem::path dotnet_root;
+
+    /// directory for cached assembly metadata images, the cache is disabled when empty
+    std::filesystem::path metadata_cache_path;
+
+    RuntimeOptions runtime;
+    /// ReadyToRun build of DotOther.Managed.dll (dotnet publish -p:PublishReadyToRun=true), loaded in place of
+    ///   managed_asm_path when it exists and runtime.ready_to_run is not false
+    std::filesystem::path managed_r2r_asm_path;
+
     /// Callbacks for managed code
     exception_callback_t exception_callback = nullptr;
     log_callback_t log_callback = nullptr;
@@ -62,6 +94,10 @@ namespace dotother {
 
       interface_bindings::FunctionTable& GetInteropInterface();
 
+      /// wall time and interop calls per startup phase so far, with the managed breakdown when requested and
+      ///   the runtime is bound
+      StartupReport GetStartupReport(bool include_managed = true) const;
+
     private:
       Host(const HostConfig& config) 
           : config(config) {}
@@ -88,6 +124,7 @@ namespace dotother {
 
       bool LoadClrFunctions();
       bool InitializeHost();
+      bool ApplyRuntimeOptions(hostfxr_handle context);
       void LoadManagedFunctions();
 
       void* LoadManagedFunction(const std::filesystem::path& asm_path, const dostring& typ_name, const dostring& method_name, 
@@ -3,25 +3,64 @@
  **/
 #include "hosting/hosted_object.hpp"
 
+#include <utility>
+
 #include "hosting/native_string.hpp"
 #include "hosting/interop_interface.hpp"
 
 namespace dotother {
 
-  void HostedObject::InvokeMethod(std::string_view method_name, const void** params, const ManagedType* types, size_t argc) {
+  HostedObject::~HostedObject() {
+    Destroy();
+  }
+
+  HostedObject::HostedObject(HostedObject&& other) noexcept
+      : managed_handle(std::exchange(other.managed_handle, nullptr)), type(std::exchange(other.type, nullptr)) {}
+
+  HostedObject& HostedObject::operator=(HostedObject&& other) noexcept {
+    if (this != &other) {
+      Destroy();
+      managed_handle = std::exchange(other.managed_handle, nullptr);
+      type = std::exchange(other.type, nullptr);
+    }
+    return *this;
+  }
+
+  void HostedObject::Destroy() {
+    if (managed_handle == nullptr) {
+      return;
+    }
+
+    /// the runtime may already be gone at shutdown, its handles went with it
+    if (Interop().BoundToAsm()) {
+      Interop().destroy_object(managed_handle);
+    }
+
+    managed_handle = nullptr;
+    type = nullptr;
+  }
+
+  NObject* HostedObject::ResolveNativeObject(uint64_t handle) {
+    if (handle == 0) {
+      return nullptr;
+    }
+    return InteropInterface::Instance().GetRegisteredObject(handle);
+  }
+
+  void HostedObject::InvokeMethod(std::string_view method_name, const void** params, uint64_t signature, size_t argc) {
     auto name = NString::New(method_name);
-    Interop().invoke_method(managed_handle, name, params, types, static_cast<int32_t>(argc));
+    Interop().invoke_method(managed_handle, name, params, signature, static_cast<int32_t>(argc));
     NString::Free(name);
   }
 
-  void HostedObject::InvokeReturningMethod(std::string_view method_name, const void** params, const ManagedType* types, 
+  void HostedObject::InvokeReturningMethod(std::string_view method_name, const void** params, uint64_t signature, 
                                             size_t argc, void* ret) {
     auto name = NString::New(method_name);
-    Interop().invoke_method_ret(managed_handle, name, params, types, static_cast<int32_t>(argc), ret);
+    Interop().invoke_method_ret(managed_handle, name, params, signature, static_cast<int32_t>(argc), ret);
     NString::Free(name);
   }
 
-  void HostedObject::WriteToField(const std::string_view name, void* value) {
+  void HostedObject::WriteToField(const std::string_view name, const void* value) {
     auto name_str = NString::New(name);
     Interop().set_field(managed_handle, name_str, value);
     NString::Free(name_str);
@@ -33,7 +72,7 @@ namespace dotother {
     NString::Free(name_str);
   }
 
-  void HostedObject::WriteToProperty(const std::string_view name, void* value) {
+  void HostedObject::WriteToProperty(const std::string_view name, const void* value) {
     auto name_str = NString::New(name);
     Interop().set_property(managed_handle, name_str, value);
     NString::Free(name_str);
@@ -13,69 +13,78 @@ namespace dotother {
 
   class Assembly;
   class Type;
+  class NObject;
 
-  template <typename T>
-  concept PtrType = std::is_pointer_v<T>;
-
-  template <typename T>
-  concept NotPtrType = !PtrType<T>;
-
+  /// Owns one GCHandle to a managed object, every HostedObject managed hands back is a fresh handle that is
+  ///   freed when the HostedObject is destroyed. Unloading the object's assembly context frees the handle as well,
+  ///   a HostedObject should not outlive its context.
   class HostedObject {
    public:
+    HostedObject() = default;
+    ~HostedObject();
+
+    HostedObject(const HostedObject&) = delete;
+    HostedObject& operator=(const HostedObject&) = delete;
+
+    HostedObject(HostedObject&& other) noexcept;
+    HostedObject& operator=(HostedObject&& other) noexcept;
+
+    /// frees the managed handle now, the object is invalid afterwards
+    void Destroy();
+
     template <typename Ret, typename... Args>
     Ret Invoke(const std::string_view name, Args&&... params) {
       constexpr size_t argc = sizeof...(params);
+      constexpr uint64_t signature = util::SignatureHash<Args...>();
 
       if constexpr (std::same_as<Ret, void>) {
         if constexpr (argc > 0) {
           const void* parameters[argc] = { 0 };
-          ManagedType param_types[argc] = {};
-          util::AddToArray<Args...>(parameters, param_types, std::forward<Args>(params)..., std::make_index_sequence<argc>{});
-          InvokeMethod(name, parameters, param_types, argc);
+          util::AddToArray<Args...>(parameters, std::forward<Args>(params)..., std::make_index_sequence<argc>{});
+          InvokeMethod(name, parameters, signature, argc);
         } else {
-          InvokeMethod(name, nullptr, nullptr, 0);
+          InvokeMethod(name, nullptr, signature, 0);
         }
       } else {
-        Ret res;
-        if constexpr (argc > 0) {
-          const void* parameters[argc] = { 0 };
-          ManagedType param_types[argc] = {};
-          util::AddToArray<Args...>(parameters, param_types, std::forward<Args>(params)..., std::make_index_sequence<argc>{});
-          InvokeReturningMethod(name, parameters, param_types, argc, &res);
-        } else {
-          InvokeReturningMethod(name, nullptr, nullptr, 0, &res);
-        }
+        return ReadReturn<Ret>([&](void* ret) {
+          if constexpr (argc > 0) {
+            const void* parameters[argc] = { 0 };
+            util::AddToArray<Args...>(parameters, std::forward<Args>(params)..., std::make_index_sequence<argc>{});
+            InvokeReturningMethod(name, parameters, signature, argc, ret);
+          } else {
+            InvokeReturningMethod(name, nullptr, signature, 0, ret);
+          }
+        });
       }
     }
 
-    void SetField(const std::string_view name, PtrType auto value) {
-      WriteToField(name, value);
-    }
-
-    void SetField(const std::string_view name, NotPtrType auto value) {
-      WriteToField(name, &value);
+    /// structs registered through DOTOTHER_MANAGED_STRUCT are read straight out of value on the managed side,
+    ///   HostedObjects and NObjects are handed over as their handles
+    void SetField(const std::string_view name, const auto& value) {
+      WriteToField(name, util::ToArgSlot(value));
     }
 
     template <typename T>
     T GetField(const std::string_view name) {
-      T res;
-      ReadFromField(name, &res);
-      return res;
+      return ReadReturn<T>([&](void* ret) { ReadFromField(name, ret); });
     }
 
-    void SetProperty(const std::string_view name, PtrType auto value) {
-      WriteToProperty(name, value);
-    }
-
-    void SetProperty(const std::string_view name, NotPtrType auto value) {
-      WriteToProperty(name, &value);
+    void SetProperty(const std::string_view name, const auto& value) {
+      WriteToProperty(name, util::ToArgSlot(value));
     }
 
     template <typename T>
     T GetProperty(const std::string_view name) {
-      T res;
-      ReadFromProperty(name, &res);
-      return res;
+      return ReadReturn<T>([&](void* ret) { ReadFromProperty(name, ret); });
+    }
+
+    /// the GCHandle of the managed object, what managed receives when this object is passed as an argument
+    void* Handle() const {
+      return managed_handle;
+    }
+
+    bool IsValid() const {
+      return managed_handle != nullptr;
     }
 
    private:
@@ -83,13 +92,37 @@ namespace dotother {
     void* managed_handle = nullptr;
     Type* type = nullptr;
 
-    void InvokeMethod(std::string_view method_name, const void** params, const ManagedType* types, size_t argc);
-    void InvokeReturningMethod(std::string_view method_name, const void** params, const ManagedType* types, size_t argc, void* ret);
+    explicit HostedObject(void* handle)
+        : managed_handle(handle) {}
+
+    /// managed hands objects back as handles, a GCHandle for managed objects and the object_handle for NObjects,
+    ///   everything else is copied into the result
+    template <typename T, typename Reader>
+    static T ReadReturn(Reader&& read) {
+      if constexpr (std::same_as<T, HostedObject>) {
+        void* handle = nullptr;
+        read(&handle);
+        return HostedObject(handle);
+      } else if constexpr (util::NativeObjectRef<T> && std::is_pointer_v<T>) {
+        uint64_t handle = 0;
+        read(&handle);
+        return static_cast<T>(ResolveNativeObject(handle));
+      } else {
+        T res{};
+        read(&res);
+        return res;
+      }
+    }
 
-    void WriteToField(const std::string_view name, void* value);
+    static NObject* ResolveNativeObject(uint64_t handle);
+
+    void InvokeMethod(std::string_view method_name, const void** params, uint64_t signature, size_t argc);
+    void InvokeReturningMethod(std::string_view method_name, const void** params, uint64_t signature, size_t argc, void* ret);
+
+    void WriteToField(const std::string_view name, const void* value);
     void ReadFromField(const std::string_view name, void* value);
 
-    void WriteToProperty(const std::string_view name, void* value);
+    void WriteToProperty(const std::string_view name, const void* value);
     void ReadFromProperty(const std::string_view name, void* value);
 
     friend class Host;
@@ -98,6 +131,9 @@ namespace dotother {
     friend class Type;
   };
 
+  /// managed writes arrays of objects as { handle, type } pairs, see ArrayObject in Marshalling.cs
+  static_assert(sizeof(HostedObject) == 2 * sizeof(void*), "HostedObject must stay a handle and a type pointer!");
+
 }  // namespace dotother
 
 #endif  // !DOTOTHER_HOSTED_OBJECT_HPP
@@ -0,0 +1,223 @@
+/**
+ * \file hosting/hostfxr_resolver.cpp
+ **/
+#include "hosting/hostfxr_resolver.hpp"
+
+#include <charconv>
+#include <cstdlib>
+#include <mutex>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#ifndef DOTOTHER_WINDOWS
+  #include <dlfcn.h>
+#endif
+
+#include <nethost.h>
+
+#include "core/utilities.hpp"
+
+namespace dotother {
+
+  namespace {
+
+    using get_hostfxr_path_fn = int(NETHOST_CALLTYPE*)(char_t*, size_t*, const get_hostfxr_parameters*);
+
+    /// HostApiBufferTooSmall, buffer_size then holds the required length
+    constexpr int kBufferTooSmall = static_cast<int>(0x80008098);
+
+    std::optional<std::filesystem::path> Existing(const std::filesystem::path& path) {
+      std::error_code ec;
+      if (path.empty() || !std::filesystem::is_regular_file(path, ec)) {
+        return std::nullopt;
+      }
+      return path;
+    }
+
+    std::optional<std::filesystem::path> FromEnvironment(int32_t major_version) {
+      const char* root = std::getenv("DOTNET_ROOT");
+      if (root == nullptr || *root == '\0') {
+        return std::nullopt;
+      }
+      return FindHostFxrInRoot(root, major_version);
+    }
+
+    std::optional<std::filesystem::path> FromNetHost(const HostFxrSearch& search) {
+#ifdef DOTOTHER_WINDOWS
+      void* nethost = LoadLibraryA(DOTOTHER_NETHOST_NAME);
+      auto get_hostfxr_path = nethost != nullptr ?
+        reinterpret_cast<get_hostfxr_path_fn>(GetProcAddress(static_cast<HMODULE>(nethost), "get_hostfxr_path")) :
+        nullptr;
+#else
+      void* nethost = dlopen(DOTOTHER_NETHOST_NAME, RTLD_NOW | RTLD_LOCAL);
+      auto get_hostfxr_path = nethost != nullptr ?
+        reinterpret_cast<get_hostfxr_path_fn>(dlsym(nethost, "get_hostfxr_path")) :
+        nullptr;
+#endif  // DOTOTHER_WINDOWS
+      if (get_hostfxr_path == nullptr) {
+        return std::nullopt;
+      }
+
+      std::filesystem::path::string_type app_path = search.app_path.native();
+      std::filesystem::path::string_type dotnet_root = search.dotnet_root.native();
+      get_hostfxr_parameters params{
+        .size = sizeof(get_hostfxr_parameters),
+        .assembly_path = app_path.empty() ? nullptr : reinterpret_cast<const char_t*>(app_path.c_str()),
+        .dotnet_root = dotnet_root.empty() ? nullptr : reinterpret_cast<const char_t*>(dotnet_root.c_str()),
+      };
+
+      std::vector<char_t> buffer(512);
+      size_t size = buffer.size();
+      int rc = get_hostfxr_path(buffer.data(), &size, &params);
+      if (rc == kBufferTooSmall) {
+        buffer.resize(size);
+        rc = get_hostfxr_path(buffer.data(), &size, &params);
+      }
+
+      if (rc != 0) {
+        DOTOTHER_LOG(DO_STR("get_hostfxr_path failed : {:#08x}"), MessageLevel::DEBUG, static_cast<uint32_t>(rc));
+        return std::nullopt;
+      }
+
+      return Existing(std::filesystem::path(reinterpret_cast<const std::filesystem::path::value_type*>(buffer.data())));
+    }
+
+    std::vector<std::filesystem::path> DefaultRoots() {
+#ifdef DOTOTHER_WINDOWS
+      TCHAR buffer[MAX_PATH];
+      if (!SHGetSpecialFolderPath(nullptr, buffer, CSIDL_PROGRAM_FILES, FALSE)) {
+        return {};
+      }
+      return { std::filesystem::path(buffer) / "dotnet" };
+#else
+      return {
+        "/usr/lib/dotnet",
+        "/usr/lib64/dotnet",
+        "/usr/share/dotnet",
+        "/usr/local/share/dotnet",
+      };
+#endif  // DOTOTHER_WINDOWS
+    }
+
+    std::optional<std::filesystem::path> Search(const HostFxrSearch& search) {
+      if (!search.hostfxr_path.empty()) {
+        return Existing(search.hostfxr_path);
+      }
+
+      if (!search.dotnet_root.empty()) {
+        if (auto res = FindHostFxrInRoot(search.dotnet_root, search.major_version); res.has_value()) {
+          return res;
+        }
+      }
+
+      if (auto res = FromEnvironment(search.major_version); res.has_value()) {
+        return res;
+      }
+
+      if (!search.app_path.empty()) {
+        if (auto res = Existing(search.app_path.parent_path() / DOTOTHER_HOSTFXR_NAME); res.has_value()) {
+          return res;
+        }
+      }
+
+      if (auto res = FromNetHost(search); res.has_value()) {
+        return res;
+      }
+
+      for (const auto& root : DefaultRoots()) {
+        if (auto res = FindHostFxrInRoot(root, search.major_version); res.has_value()) {
+          return res;
+        }
+      }
+
+      return std::nullopt;
+    }
+
+  }  // namespace
+
+  std::optional<FxrVersion> FxrVersion::Parse(std::string_view name) {
+    FxrVersion version;
+
+    std::string_view numbers = name;
+    if (size_t dash = name.find('-'); dash != std::string_view::npos) {
+      numbers = name.substr(0, dash);
+      version.release = false;
+    }
+
+    const char* itr = numbers.data();
+    const char* end = numbers.data() + numbers.size();
+    for (size_t i = 0; i < version.parts.size(); ++i) {
+      auto [next, ec] = std::from_chars(itr, end, version.parts[i]);
+      if (ec != std::errc{}) {
+        return std::nullopt;
+      }
+
+      itr = next;
+      if (i + 1 < version.parts.size()) {
+        if (itr == end || *itr != '.') {
+          return std::nullopt;
+        }
+        ++itr;
+      }
+    }
+
+    if (itr != end) {
+      return std::nullopt;
+    }
+
+    return version;
+  }
+
+  std::optional<std::filesystem::path> FindHostFxrInRoot(const std::filesystem::path& root, int32_t major_version) {
+    std::error_code ec;
+    std::filesystem::directory_iterator itr(root / "host" / "fxr", ec);
+    if (ec) {
+      return std::nullopt;
+    }
+
+    std::optional<FxrVersion> best;
+    std::filesystem::path best_path;
+    for (const auto& entry : itr) {
+      if (!entry.is_directory(ec)) {
+        continue;
+      }
+
+      std::optional<FxrVersion> version = FxrVersion::Parse(entry.path().filename().string());
+      if (!version.has_value() || version->parts[0] != major_version || (best.has_value() && *version <= *best)) {
+        continue;
+      }
+
+      if (auto hostfxr = Existing(entry.path() / DOTOTHER_HOSTFXR_NAME); hostfxr.has_value()) {
+        best = version;
+        best_path = *hostfxr;
+      }
+    }
+
+    if (!best.has_value()) {
+      return std::nullopt;
+    }
+    return best_path;
+  }
+
+  std::optional<std::filesystem::path> ResolveHostFxr(const HostFxrSearch& search) {
+    static std::mutex mutex;
+    static std::optional<HostFxrSearch> cached_search;
+    static std::optional<std::filesystem::path> cached;
+
+    std::scoped_lock lock(mutex);
+    if (cached.has_value() && cached_search == search) {
+      return cached;
+    }
+
+    /// misses are not cached, a runtime installed after a failed load is found on the next one
+    std::optional<std::filesystem::path> res = Search(search);
+    if (res.has_value()) {
+      DOTOTHER_LOG(DO_STR("Resolved hostfxr : {}"), MessageLevel::DEBUG, res->string());
+      cached = res;
+      cached_search = search;
+    }
+    return res;
+  }
+
+}  // namespace dotother
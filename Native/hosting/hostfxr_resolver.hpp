@@ -0,0 +1,54 @@
+/**
+ * \file hosting/hostfxr_resolver.hpp
+ **/
+#ifndef DOTOTHER_HOSTFXR_RESOLVER_HPP
+#define DOTOTHER_HOSTFXR_RESOLVER_HPP
+
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string_view>
+
+#include "core/dotother_defines.hpp"
+
+namespace dotother {
+
+  struct HostFxrSearch {
+    /// used as is when set, nothing else is searched
+    std::filesystem::path hostfxr_path;
+    /// searched before DOTNET_ROOT and the default install locations
+    std::filesystem::path dotnet_root;
+    /// the managed assembly, its directory holds the runtime of a self-contained app
+    std::filesystem::path app_path;
+    int32_t major_version = DOTOTHER_DOTNET_TARGET_VERSION_MAJOR;
+
+    bool operator==(const HostFxrSearch&) const = default;
+  };
+
+  /// "major.minor.patch[-label]" of a host/fxr directory, releases order above prereleases of the same version
+  struct FxrVersion {
+    std::array<int32_t, 3> parts{};
+    bool release = true;
+
+    static std::optional<FxrVersion> Parse(std::string_view name);
+
+    auto operator<=>(const FxrVersion&) const = default;
+  };
+
+  /// Resolution order, first hit wins:
+  ///   1. search.hostfxr_path
+  ///   2. search.dotnet_root, then $DOTNET_ROOT
+  ///   3. hostfxr next to search.app_path (self-contained or app-local runtime)
+  ///   4. nethost's get_hostfxr_path, when the nethost library can be loaded
+  ///   5. the default install locations
+  /// Roots are searched through FindHostFxrInRoot. A hit is cached per search, repeated loads don't touch the
+  ///   file system.
+  std::optional<std::filesystem::path> ResolveHostFxr(const HostFxrSearch& search);
+
+  /// <root>/host/fxr/<version>/hostfxr for the highest version with the given major, one directory listing
+  std::optional<std::filesystem::path> FindHostFxrInRoot(const std::filesystem::path& root, int32_t major_version);
+
+}  // namespace dotother
+
+#endif  // !DOTOTHER_HOSTFXR_RESOLVER_HPP
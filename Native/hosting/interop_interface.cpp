@@ -3,6 +3,8 @@
  **/
 #include "hosting/interop_interface.hpp"
 
+#include <type_traits>
+
 #include <refl/refl.hpp>
 
 #include "core/utilities.hpp"
@@ -13,78 +15,122 @@
 namespace dotother {
   namespace interface_bindings {
 
-    bool FunctionTable::BoundToAsm() const {
-      return (
-        create_assembly_load_context != nullptr &&
-        unload_assembly_load_context != nullptr &&
-        load_assembly != nullptr &&
-        get_last_load_status != nullptr &&
-        get_assembly_name != nullptr &&
+    namespace {
+
+      /// visits every entry of the table with its name, the order does not matter since tags are matched by name
+      template <typename Table, typename Fn>
+      constexpr void ForEachEntry(Table& table, Fn&& fn) {
+#define DOTOTHER_TABLE_ENTRY(entry) fn(table.entry, std::string_view(#entry))
+        DOTOTHER_TABLE_ENTRY(create_assembly_load_context);
+        DOTOTHER_TABLE_ENTRY(unload_assembly_load_context);
+        DOTOTHER_TABLE_ENTRY(load_assembly);
+        DOTOTHER_TABLE_ENTRY(get_last_load_status);
+        DOTOTHER_TABLE_ENTRY(get_assembly_name);
 
         /// type functions
-        get_net_core_types != nullptr &&
-        get_asm_types != nullptr &&
-        get_type_id != nullptr &&
-        get_full_type_name != nullptr &&
-        get_asm_qualified_name != nullptr &&
-        get_base_type != nullptr &&
-        get_type_size != nullptr &&
-        is_type_derived_from != nullptr &&
-        is_assignable_to != nullptr &&
-        is_assignable_from != nullptr &&
-        is_type_sz_array != nullptr &&
-        get_element_type != nullptr &&
-        get_type_methods != nullptr &&
-        get_type_fields != nullptr &&
-        get_type_properties != nullptr &&
-        has_type_attribute != nullptr &&
-        get_type_attributes != nullptr &&
-        get_type_managed_type != nullptr &&
+        DOTOTHER_TABLE_ENTRY(get_net_core_types);
+        DOTOTHER_TABLE_ENTRY(get_asm_types);
+        DOTOTHER_TABLE_ENTRY(get_type_id);
+        DOTOTHER_TABLE_ENTRY(make_generic_type);
+        DOTOTHER_TABLE_ENTRY(get_full_type_name);
+        DOTOTHER_TABLE_ENTRY(get_asm_qualified_name);
+        DOTOTHER_TABLE_ENTRY(get_base_type);
+        DOTOTHER_TABLE_ENTRY(get_type_size);
+        DOTOTHER_TABLE_ENTRY(is_type_derived_from);
+        DOTOTHER_TABLE_ENTRY(is_assignable_to);
+        DOTOTHER_TABLE_ENTRY(is_assignable_from);
+        DOTOTHER_TABLE_ENTRY(is_type_sz_array);
+        DOTOTHER_TABLE_ENTRY(get_element_type);
+        DOTOTHER_TABLE_ENTRY(get_type_methods);
+        DOTOTHER_TABLE_ENTRY(get_type_fields);
+        DOTOTHER_TABLE_ENTRY(get_type_properties);
+        DOTOTHER_TABLE_ENTRY(has_type_attribute);
+        DOTOTHER_TABLE_ENTRY(get_type_attributes);
+        DOTOTHER_TABLE_ENTRY(get_type_managed_type);
+        DOTOTHER_TABLE_ENTRY(export_assembly_metadata);
+        DOTOTHER_TABLE_ENTRY(bind_assembly_metadata);
+        DOTOTHER_TABLE_ENTRY(bind_type_members);
+        DOTOTHER_TABLE_ENTRY(get_metadata_key);
 
         /// field functions
-        get_field_name != nullptr &&
-        get_field_type != nullptr &&
-        get_field_attributes != nullptr &&
-        get_field_accessibility != nullptr &&
+        DOTOTHER_TABLE_ENTRY(get_field_name);
+        DOTOTHER_TABLE_ENTRY(get_field_type);
+        DOTOTHER_TABLE_ENTRY(get_field_attributes);
+        DOTOTHER_TABLE_ENTRY(get_field_accessibility);
 
         /// property functions
-        get_property_name != nullptr &&
-        get_property_type != nullptr &&
-        get_property_attributes != nullptr &&
+        DOTOTHER_TABLE_ENTRY(get_property_name);
+        DOTOTHER_TABLE_ENTRY(get_property_type);
+        DOTOTHER_TABLE_ENTRY(get_property_attributes);
 
         /// attribute functions
-        get_attr_value != nullptr &&
-        get_attr_type != nullptr &&
+        DOTOTHER_TABLE_ENTRY(get_attr_value);
+        DOTOTHER_TABLE_ENTRY(get_attr_type);
+        DOTOTHER_TABLE_ENTRY(get_attr_snapshot);
 
         /// method functions
-        get_method_name != nullptr &&
-        get_method_return_type != nullptr &&
-        get_method_param_types != nullptr &&
-        get_method_attributes != nullptr &&
-        get_method_accessibility != nullptr &&
+        DOTOTHER_TABLE_ENTRY(get_method_name);
+        DOTOTHER_TABLE_ENTRY(get_method_return_type);
+        DOTOTHER_TABLE_ENTRY(get_method_param_types);
+        DOTOTHER_TABLE_ENTRY(get_method_attributes);
+        DOTOTHER_TABLE_ENTRY(get_method_accessibility);
+        DOTOTHER_TABLE_ENTRY(get_method_signature);
 
-        set_internal_calls != nullptr &&
-        set_internal_call != nullptr &&
+        DOTOTHER_TABLE_ENTRY(set_internal_calls);
+        DOTOTHER_TABLE_ENTRY(set_internal_call);
 
         /// object functions
-        create_object != nullptr &&
-        destroy_object != nullptr &&
+        DOTOTHER_TABLE_ENTRY(create_object);
+        DOTOTHER_TABLE_ENTRY(destroy_object);
+        DOTOTHER_TABLE_ENTRY(release_native_object);
+
+        DOTOTHER_TABLE_ENTRY(invoke_method);
+        DOTOTHER_TABLE_ENTRY(invoke_method_ret);
+
+        DOTOTHER_TABLE_ENTRY(invoke_static_method);
+        DOTOTHER_TABLE_ENTRY(invoke_static_method_ret);
+
+        DOTOTHER_TABLE_ENTRY(set_field);
+        DOTOTHER_TABLE_ENTRY(get_field);
 
-        invoke_method != nullptr &&
-        invoke_method_ret != nullptr &&
+        DOTOTHER_TABLE_ENTRY(set_property);
+        DOTOTHER_TABLE_ENTRY(get_property);
 
-        invoke_static_method != nullptr &&
-        invoke_static_method_ret != nullptr &&
+        DOTOTHER_TABLE_ENTRY(collect_garbage);
+        DOTOTHER_TABLE_ENTRY(wait_for_pending_finalizers);
 
-        set_field != nullptr &&
-        get_field != nullptr &&
+        DOTOTHER_TABLE_ENTRY(get_startup_timings);
+#undef DOTOTHER_TABLE_ENTRY
+      }
 
-        set_property != nullptr &&
-        get_property != nullptr &&
+      constexpr size_t CountEntries() {
+        FunctionTable table;
+        size_t count = 0;
+        ForEachEntry(table, [&](auto&, std::string_view) { ++count; });
+        return count;
+      }
 
-        collect_garbage != nullptr &&
-        wait_for_pending_finalizers != nullptr
-      );
+      static_assert(CountEntries() * sizeof(void*) == sizeof(FunctionTable) - offsetof(FunctionTable, create_assembly_load_context),
+                    "Every FunctionTable entry must be listed in ForEachEntry!");
+
+    }  // namespace
+
+    void FunctionTable::StampEntries() {
+      ForEachEntry(*this, [](auto& entry, std::string_view name) {
+        entry = reinterpret_cast<std::remove_reference_t<decltype(entry)>>(EntryTag(name));
+      });
+    }
+
+    bool FunctionTable::BoundToAsm() const {
+      if (version != kFunctionTableVersion || size != sizeof(FunctionTable)) {
+        return false;
+      }
+
+      bool bound = true;
+      ForEachEntry(*this, [&](const auto& entry, std::string_view name) {
+        bound = bound && entry != nullptr && reinterpret_cast<uintptr_t>(entry) != EntryTag(name);
+      });
+      return bound;
     }
 
   }  // namespace interface_bindings
@@ -140,6 +186,9 @@ namespace dotother {
     if (auto itr = registered_objects.find(handle); itr != registered_objects.end()) {
       DOTOTHER_LOG(DO_STR("Unregistering object {:#8x} ({})"sv), MessageLevel::INFO, handle, itr->second->proxy->GetTypeName());
       registered_objects.erase(itr);
+
+      /// drop the managed wrapper so a stale handle can not resolve to a dead object
+      Interop().release_native_object(handle);
       return;
     }
 
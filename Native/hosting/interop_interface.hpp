@@ -4,24 +4,32 @@
 #ifndef DOTOTHER_NATIVE_INTEROP_INTERFACE_HPP
 #define DOTOTHER_NATIVE_INTEROP_INTERFACE_HPP
 
+#include <cstddef>
 #include <cstdint>
 #include <map>
+#include <string_view>
 
 #include "core/dotother_defines.hpp"
+#include "core/utilities.hpp"
 
 #include "hosting/garbage_collector.hpp"
 #include "hosting/native_object.hpp"
 #include "hosting/native_string.hpp"
+#include "hosting/startup_profile.hpp"
 
 namespace dotother {
 
+  namespace metadata {
+    struct CacheKey;
+  }  // namespace metadata
+
   struct InternalCall {
     const dochar* name;
     void* native_function;
   };
 
   using CreateAssemblyLoadContext = int32_t (*)(NString);
-  using UnloadAssemblyLoadContext = void (*)(int32_t);
+  using UnloadAssemblyLoadContext = void (*)(int32_t, int32_t**, int32_t*);
   using LoadAssembly = int32_t (*)(int32_t, NString);
   using GetLastLoadStatus = AssemblyLoadStatus (*)();
   using GetAssemblyName = NString (*)(int32_t);
@@ -30,7 +38,12 @@ namespace dotother {
 
   using GetNetCoreTypes = void (*)(int32_t*, int32_t*);
   using GetAsmTypes = void (*)(int32_t, int32_t*, int32_t*);
+  using ExportAssemblyMetadata = void (*)(int32_t, void**, int32_t*);
+  using BindAssemblyMetadata = nbool32 (*)(int32_t, const void*, int32_t, int32_t*, int32_t);
+  using BindTypeMembers = nbool32 (*)(int32_t, const void*, int32_t, int32_t, int32_t*, int32_t);
+  using GetMetadataKey = void (*)(int32_t, metadata::CacheKey*);
   using GetTypeId = void (*)(NString, int32_t*);
+  using MakeGenericType = void (*)(int32_t, const int32_t*, int32_t, int32_t*);
   using GetFullTypeName = NString (*)(int32_t);
   using GetAsmQualifiedName = NString (*)(int32_t);
   using GetBaseType = void (*)(int32_t, int32_t*);
@@ -65,6 +78,7 @@ namespace dotother {
 #pragma region Attribute
   using GetAttributeValue = void (*)(int32_t, NString, void*);
   using GetAttributeType = void (*)(int32_t, int32_t*);
+  using GetAttributeSnapshot = void (*)(int32_t, void**, int32_t*);
 #pragma endregion
 
 #pragma region Method
@@ -73,32 +87,61 @@ namespace dotother {
   using GetMethodParameterTypes = void (*)(int32_t, int32_t*, int32_t*);
   using GetMethodAccessibility = TypeAccessibility (*)(int32_t);
   using GetMethodAttributes = void (*)(int32_t, int32_t*, int32_t*);
+  using GetMethodSignature = uint64_t (*)(int32_t);
 #pragma endregion
 
   using SetInternalCalls = void (*)(void*, int32_t);
   using SetInternalCall = void (*)(InternalCall);
 
-  using CreateObject = void* (*)(int32_t, nbool32, const void**, const ManagedType*, int32_t);
+  using CreateObject = void* (*)(int32_t, nbool32, const void**, uint64_t, int32_t);
   using DestroyObject = void (*)(void*);
+  using ReleaseNativeObject = void (*)(uint64_t);
 
-  using InvokeMethod = void (*)(void*, NString, const void**, const ManagedType*, int32_t);
-  using InvokeMethodRet = void (*)(void*, NString, const void**, const ManagedType*, int32_t, void*);
+  using InvokeMethod = void (*)(void*, NString, const void**, uint64_t, int32_t);
+  using InvokeMethodRet = void (*)(void*, NString, const void**, uint64_t, int32_t, void*);
 
-  using InvokeStaticMethod = void (*)(int32_t, NString, const void**, const ManagedType*, int32_t);
-  using InvokeStaticMethodRet = void (*)(int32_t, NString, const void**, const ManagedType*, int32_t, void*);
+  using InvokeStaticMethod = void (*)(int32_t, NString, const void**, uint64_t, int32_t);
+  using InvokeStaticMethodRet = void (*)(int32_t, NString, const void**, uint64_t, int32_t, void*);
 
-  using SetField = void (*)(void*, NString, void*);
+  using SetField = void (*)(void*, NString, const void*);
   using GetField = void (*)(void*, NString, void*);
 
-  using SetProperty = void (*)(void*, NString, void*);
+  using SetProperty = void (*)(void*, NString, const void*);
   using GetProperty = void (*)(void*, NString, void*);
 
   using CollectGarbage = void (*)(int32_t, GCMode, nbool32, nbool32);
   using WaitForPendingFinalizers = void (*)();
 
+  using GetStartupTimings = void (*)(int64_t*, int32_t);
+
   namespace interface_bindings {
 
+    /// bump with DotOther.Managed.FunctionTable.Version whenever an entry is added, removed or changes signature
+    constexpr uint32_t kFunctionTableVersion = 3;
+
+    /// Placeholder written into an entry before the bootstrap fills it: FNV-1a of the entry name with underscores
+    ///   dropped and letters lowered, so get_last_load_status and GetLastLoadStatus share a tag. The bootstrap
+    ///   checks every slot against its own field name, which catches entries that are in a different order on
+    ///   each side even when the version and size agree.
+    constexpr uintptr_t EntryTag(std::string_view name) {
+      uint64_t hash = util::kFnvOffsetBasis;
+      for (char c : name) {
+        if (c == '_') {
+          continue;
+        }
+
+        hash ^= static_cast<uint8_t>(c >= 'A' && c <= 'Z' ? c - 'A' + 'a' : c);
+        hash *= util::kFnvPrime;
+      }
+      return static_cast<uintptr_t>(hash);
+    }
+
+    /// Filled in one call by the managed bootstrap (DotOther.Managed.InteropBootstrap), which mirrors this layout
+    ///   entry for entry. The header tells it which layout it is writing into.
     struct FunctionTable {
+      uint32_t version = kFunctionTableVersion;
+      uint32_t size = sizeof(FunctionTable);
+
       CreateAssemblyLoadContext create_assembly_load_context = nullptr;
       UnloadAssemblyLoadContext unload_assembly_load_context = nullptr;
       LoadAssembly load_assembly = nullptr;
@@ -110,6 +153,7 @@ namespace dotother {
       GetNetCoreTypes get_net_core_types = nullptr;
       GetAsmTypes get_asm_types = nullptr;
       GetTypeId get_type_id = nullptr;
+      MakeGenericType make_generic_type = nullptr;
       GetFullTypeName get_full_type_name = nullptr;
       GetAsmQualifiedName get_asm_qualified_name = nullptr;
       GetBaseType get_base_type = nullptr;
@@ -125,6 +169,10 @@ namespace dotother {
       HasTypeAttribute has_type_attribute = nullptr;
       GetTypeAttributes get_type_attributes = nullptr;
       GetTypeManagedType get_type_managed_type = nullptr;
+      ExportAssemblyMetadata export_assembly_metadata = nullptr;
+      BindAssemblyMetadata bind_assembly_metadata = nullptr;
+      BindTypeMembers bind_type_members = nullptr;
+      GetMetadataKey get_metadata_key = nullptr;
 
 #pragma endregion
 
@@ -144,6 +192,7 @@ namespace dotother {
 #pragma region Attribute
       GetAttributeValue get_attr_value = nullptr;
       GetAttributeType get_attr_type = nullptr;
+      GetAttributeSnapshot get_attr_snapshot = nullptr;
 #pragma endregion
 
 #pragma region Method
@@ -152,6 +201,7 @@ namespace dotother {
       GetMethodParameterTypes get_method_param_types = nullptr;
       GetMethodAttributes get_method_attributes = nullptr;
       GetMethodAccessibility get_method_accessibility = nullptr;
+      GetMethodSignature get_method_signature = nullptr;
 #pragma endregion
 
       SetInternalCalls set_internal_calls = nullptr;
@@ -159,6 +209,7 @@ namespace dotother {
 
       CreateObject create_object = nullptr;
       DestroyObject destroy_object = nullptr;
+      ReleaseNativeObject release_native_object = nullptr;
 
       InvokeMethod invoke_method = nullptr;
       InvokeMethodRet invoke_method_ret = nullptr;
@@ -175,14 +226,26 @@ namespace dotother {
       CollectGarbage collect_garbage = nullptr;
       WaitForPendingFinalizers wait_for_pending_finalizers = nullptr;
 
+      GetStartupTimings get_startup_timings = nullptr;
+
+      /// writes each entry's EntryTag into its slot, call right before handing the table to the bootstrap
+      void StampEntries();
+
+      /// true once every entry holds a function, an entry still carrying its tag was never filled
       bool BoundToAsm() const;
 
       constexpr FunctionTable() {
       }
     };
 
+    static_assert(offsetof(FunctionTable, create_assembly_load_context) == 2 * sizeof(uint32_t) &&
+                  (sizeof(FunctionTable) - offsetof(FunctionTable, create_assembly_load_context)) % sizeof(void*) == 0,
+                  "FunctionTable must be a header followed by function pointers only!");
+
   }  // namespace interface_bindings
 
+  using BootstrapInterop = nbool32 (*)(interface_bindings::FunctionTable*);
+
   struct MethodKey {
     NString method_name;
     uint64_t type_id = 0;
@@ -245,6 +308,7 @@ namespace dotother {
   };
 
   static inline interface_bindings::FunctionTable& Interop() {
+    StartupProfile::Instance().CountInteropCall();
     return InteropInterface::Instance().FunctionTable();
   }
 
@@ -0,0 +1,553 @@
+/**
+ * \file hosting/metadata_image.cpp
+ **/
+#include "hosting/metadata_image.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <fstream>
+#include <system_error>
+
+#ifdef _WIN32
+  #include <Windows.h>
+#else
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+#endif  // _WIN32
+
+#include "core/string_pool.hpp"
+#include "core/utilities.hpp"
+
+#include "hosting/assembly.hpp"
+#include "hosting/interop_interface.hpp"
+#include "hosting/memory.hpp"
+#include "hosting/type.hpp"
+#include "hosting/type_cache.hpp"
+#include "hosting/type_index.hpp"
+
+namespace dotother {
+
+  ref<MetadataImage> MetadataImage::Export(int32_t asm_id) {
+    void* data = nullptr;
+    int32_t size = 0;
+    Interop().export_assembly_metadata(asm_id, &data, &size);
+
+    if (data == nullptr || size <= 0) {
+      DOTOTHER_LOG(DO_STR("MetadataImage::Export: assembly {} produced no metadata"), MessageLevel::ERR, asm_id);
+      return nullptr;
+    }
+
+    ref<MetadataImage> image{ new MetadataImage };
+    image->hglobal = data;
+    image->bytes = { static_cast<const std::byte*>(data), static_cast<size_t>(size) };
+
+    if (!image->Validate()) {
+      DOTOTHER_LOG(DO_STR("MetadataImage::Export: metadata for assembly {} is malformed"), MessageLevel::ERR, asm_id);
+      return nullptr;
+    }
+
+    return image;
+  }
+
+  ref<MetadataImage> MetadataImage::FromBytes(std::vector<std::byte> bytes) {
+    ref<MetadataImage> image{ new MetadataImage };
+    image->storage = std::move(bytes);
+    image->bytes = image->storage;
+
+    if (!image->Validate()) {
+      return nullptr;
+    }
+
+    return image;
+  }
+
+  ref<MetadataImage> MetadataImage::Map(const std::filesystem::path& path) {
+    std::error_code ec;
+    uintmax_t size = std::filesystem::file_size(path, ec);
+    if (ec || size < sizeof(metadata::Header)) {
+      return nullptr;
+    }
+
+#ifdef _WIN32
+    HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+      return nullptr;
+    }
+
+    /// the view keeps the mapping alive, neither handle is needed past this point
+    HANDLE file_mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file);
+    if (file_mapping == nullptr) {
+      return nullptr;
+    }
+
+    void* view = MapViewOfFile(file_mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(file_mapping);
+    if (view == nullptr) {
+      return nullptr;
+    }
+#else
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd == -1) {
+      return nullptr;
+    }
+
+    void* view = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (view == MAP_FAILED) {
+      return nullptr;
+    }
+#endif  // _WIN32
+
+    ref<MetadataImage> image{ new MetadataImage };
+    image->mapping = view;
+    image->bytes = { static_cast<const std::byte*>(view), static_cast<size_t>(size) };
+
+    if (!image->Validate()) {
+      DOTOTHER_LOG(DO_STR("MetadataImage::Map: cached metadata {} is malformed"), MessageLevel::WARNING, path.string());
+      return nullptr;
+    }
+
+    return image;
+  }
+
+  metadata::CacheKey MetadataImage::Key(int32_t asm_id) {
+    metadata::CacheKey key{};
+    Interop().get_metadata_key(asm_id, &key);
+    return key;
+  }
+
+  MetadataImage::~MetadataImage() {
+    if (hglobal != nullptr) {
+      Memory::FreeHGlobal(hglobal);
+      hglobal = nullptr;
+    }
+
+    if (mapping != nullptr) {
+#ifdef _WIN32
+      UnmapViewOfFile(mapping);
+#else
+      munmap(mapping, bytes.size());
+#endif  // _WIN32
+      mapping = nullptr;
+    }
+  }
+
+  const metadata::Header& MetadataImage::Header() const {
+    return *reinterpret_cast<const metadata::Header*>(bytes.data());
+  }
+
+  std::span<const std::byte> MetadataImage::Bytes() const {
+    return bytes;
+  }
+
+  std::span<const metadata::TypeRecord> MetadataImage::Types() const {
+    return SectionSpan<metadata::TypeRecord>(Header().types);
+  }
+
+  std::span<const metadata::ExternalTypeRecord> MetadataImage::Externals() const {
+    return SectionSpan<metadata::ExternalTypeRecord>(Header().externals);
+  }
+
+  std::span<const metadata::MethodRecord> MetadataImage::Methods() const {
+    return SectionSpan<metadata::MethodRecord>(Header().methods);
+  }
+
+  std::span<const metadata::FieldRecord> MetadataImage::Fields() const {
+    return SectionSpan<metadata::FieldRecord>(Header().fields);
+  }
+
+  std::span<const metadata::PropertyRecord> MetadataImage::Properties() const {
+    return SectionSpan<metadata::PropertyRecord>(Header().properties);
+  }
+
+  std::span<const metadata::AttributeRecord> MetadataImage::Attributes() const {
+    return SectionSpan<metadata::AttributeRecord>(Header().attributes);
+  }
+
+  std::span<const uint32_t> MetadataImage::TypeRefs() const {
+    return SectionSpan<uint32_t>(Header().type_refs);
+  }
+
+  std::string_view MetadataImage::String(uint32_t offset) const {
+    const auto& strings = Header().strings;
+    if (static_cast<uint64_t>(offset) + sizeof(uint32_t) > strings.count) {
+      return {};
+    }
+
+    const std::byte* entry = bytes.data() + strings.offset + offset;
+
+    uint32_t length = 0;
+    std::memcpy(&length, entry, sizeof(uint32_t));
+    if (static_cast<uint64_t>(offset) + sizeof(uint32_t) + length > strings.count) {
+      return {};
+    }
+
+    return { reinterpret_cast<const char*>(entry + sizeof(uint32_t)), length };
+  }
+
+  size_t MetadataImage::RecordCount() const {
+    return Bases().attributes + Header().attributes.count;
+  }
+
+  MetadataImage::RecordBases MetadataImage::Bases() const {
+    const auto& header = Header();
+
+    RecordBases bases;
+    bases.externals = header.types.count;
+    bases.methods = bases.externals + header.externals.count;
+    bases.fields = bases.methods + header.methods.count;
+    bases.properties = bases.fields + header.fields.count;
+    bases.attributes = bases.properties + header.properties.count;
+    return bases;
+  }
+
+  bool MetadataImage::Validate() const {
+    if (bytes.size() < sizeof(metadata::Header)) {
+      return false;
+    }
+
+    const auto& header = Header();
+    if (header.magic != metadata::kMagic || header.version != metadata::kVersion || header.size > bytes.size()) {
+      return false;
+    }
+
+    auto fits = [&](const metadata::Section& section, size_t stride) {
+      return static_cast<uint64_t>(section.offset) + static_cast<uint64_t>(section.count) * stride <= header.size;
+    };
+
+    bool sections_fit = fits(header.types, sizeof(metadata::TypeRecord)) &&
+                        fits(header.externals, sizeof(metadata::ExternalTypeRecord)) &&
+                        fits(header.methods, sizeof(metadata::MethodRecord)) &&
+                        fits(header.fields, sizeof(metadata::FieldRecord)) &&
+                        fits(header.properties, sizeof(metadata::PropertyRecord)) &&
+                        fits(header.attributes, sizeof(metadata::AttributeRecord)) &&
+                        fits(header.type_refs, sizeof(uint32_t)) &&
+                        fits(header.strings, 1);
+    if (!sections_fit) {
+      return false;
+    }
+
+    /// images may come from disk, member ranges are indexed without further checks
+    auto in = [](const metadata::Range& range, uint32_t count) {
+      return static_cast<uint64_t>(range.first) + range.count <= count;
+    };
+
+    for (const auto& type : Types()) {
+      if (!in(type.methods, header.methods.count) || !in(type.fields, header.fields.count) ||
+          !in(type.properties, header.properties.count) || !in(type.attributes, header.attributes.count) ||
+          !in(type.ancestors, header.type_refs.count) || !in(type.interfaces, header.type_refs.count)) {
+        return false;
+      }
+    }
+
+    for (const auto& method : Methods()) {
+      if (!in(method.params, header.type_refs.count) || !in(method.attributes, header.attributes.count)) {
+        return false;
+      }
+    }
+
+    for (const auto& field : Fields()) {
+      if (!in(field.attributes, header.attributes.count)) {
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+  bool MetadataImage::Save(const std::filesystem::path& path) const {
+    std::error_code ec;
+    std::filesystem::create_directories(path.parent_path(), ec);
+
+    std::filesystem::path tmp = path;
+    tmp += ".tmp";
+
+    {
+      std::ofstream file(tmp, std::ios::binary | std::ios::trunc);
+      file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+      if (!file) {
+        DOTOTHER_LOG(DO_STR("MetadataImage::Save: failed to write {}"), MessageLevel::WARNING, tmp.string());
+        return false;
+      }
+    }
+
+    /// readers only ever see a complete image
+    std::filesystem::rename(tmp, path, ec);
+    if (ec) {
+      DOTOTHER_LOG(DO_STR("MetadataImage::Save: failed to move {} into place : {}"), MessageLevel::WARNING, path.string(), ec.message());
+      std::filesystem::remove(tmp, ec);
+      return false;
+    }
+
+    return true;
+  }
+
+  template <typename Resolve, typename Id>
+  void MetadataImage::FillMembers(Type& type, const metadata::TypeRecord& record, Resolve&& resolve, Id&& id,
+                                  bool with_attributes) const {
+    auto methods = Methods();
+    auto fields = Fields();
+    auto properties = Properties();
+    auto attributes = Attributes();
+    auto type_refs = TypeRefs();
+    const RecordBases bases = Bases();
+
+    StringPool& names = StringPool::Instance();
+
+    auto load_attributes = [&](const metadata::Range& range, std::vector<Attribute>& res) {
+      res.clear();
+      res.reserve(range.count);
+      for (uint32_t a = range.first; a < range.first + range.count; ++a) {
+        Attribute& attribute = res.emplace_back(id(bases.attributes, a, attributes[a].id));
+        attribute.type = resolve(attributes[a].type);
+      }
+    };
+
+    type.methods.clear();
+    type.methods.reserve(record.methods.count);
+    for (uint32_t m = record.methods.first; m < record.methods.first + record.methods.count; ++m) {
+      const auto& mrecord = methods[m];
+      Method& method = type.methods.emplace_back(id(bases.methods, m, mrecord.id));
+      method.name = names.Intern(String(mrecord.name));
+      method.signature = mrecord.signature;
+      method.ret_type = resolve(mrecord.return_type);
+
+      method.param_types.reserve(mrecord.params.count);
+      for (uint32_t param : type_refs.subspan(mrecord.params.first, mrecord.params.count)) {
+        method.param_types.push_back(resolve(param));
+      }
+      method.params_loaded = true;
+
+      if (with_attributes) {
+        load_attributes(mrecord.attributes, method.attributes);
+        method.attributes_loaded = true;
+      }
+    }
+
+    type.fields.clear();
+    type.fields.reserve(record.fields.count);
+    for (uint32_t f = record.fields.first; f < record.fields.first + record.fields.count; ++f) {
+      const auto& frecord = fields[f];
+      Field& field = type.fields.emplace_back(id(bases.fields, f, frecord.id));
+      field.name = names.Intern(String(frecord.name));
+      field.type = resolve(frecord.type);
+
+      if (with_attributes) {
+        load_attributes(frecord.attributes, field.attributes);
+        field.attributes_loaded = true;
+      }
+    }
+
+    type.properties.clear();
+    type.properties.reserve(record.properties.count);
+    for (uint32_t p = record.properties.first; p < record.properties.first + record.properties.count; ++p) {
+      const auto& precord = properties[p];
+      Property& property = type.properties.emplace_back(id(bases.properties, p, precord.id));
+      property.name = names.Intern(String(precord.name));
+      property.type = resolve(precord.type);
+    }
+
+    if (with_attributes) {
+      load_attributes(record.attributes, type.attributes);
+    }
+  }
+
+  bool MetadataImage::Import(Assembly& assembly, TypeCache::Batch& batch, const ref<ImageBinding>& binding) const {
+    auto types = Types();
+    auto externals = Externals();
+    auto type_refs = TypeRefs();
+    const RecordBases bases = Bases();
+
+    if (binding != nullptr && binding->handles.size() != RecordCount()) {
+      DOTOTHER_LOG(DO_STR("MetadataImage::Import: expected [{}] handles, got [{}]"), MessageLevel::WARNING, RecordCount(),
+                   binding->handles.size());
+      return false;
+    }
+
+    auto id = [&](size_t base, size_t idx, int32_t recorded) {
+      return binding == nullptr ? recorded : binding->handles[base + idx];
+    };
+
+    /// the assembly's own types and every external it references are staged together, see AssemblyContext::ImportTypes.
+    ///   A bound image leaves the externals only member signatures reference unbound, they are cached with the members
+    std::vector<TypeCache::PendingType> pending;
+    std::vector<size_t> pending_externals;
+    pending.reserve(types.size() + externals.size());
+    pending_externals.reserve(externals.size());
+    for (size_t i = 0; i < types.size(); ++i) {
+      pending.push_back({ id(0, i, types[i].id), String(types[i].full_name), String(types[i].nspace), assembly.asm_id });
+    }
+    for (size_t i = 0; i < externals.size(); ++i) {
+      if (int32_t handle = id(bases.externals, i, externals[i].id); handle != -1) {
+        pending.push_back({ handle, String(externals[i].full_name) });
+        pending_externals.push_back(i);
+      }
+    }
+
+    std::vector<bool> owned;
+    std::vector<Type*> cached = TypeCache::Instance().CacheTypes(pending, batch, &owned);
+    std::vector<Type*> local_types(cached.begin(), cached.begin() + static_cast<ptrdiff_t>(types.size()));
+    std::vector<Type*> external_types(externals.size(), nullptr);
+    for (size_t i = 0; i < pending_externals.size(); ++i) {
+      external_types[pending_externals[i]] = cached[types.size() + i];
+    }
+
+    std::vector<TypeIndex::Entry> index_entries;
+    index_entries.reserve(types.size());
+    for (size_t i = 0; i < types.size(); ++i) {
+      if (local_types[i] != nullptr) {
+        index_entries.push_back({ pending[i].full_name, local_types[i] });
+      }
+    }
+    assembly.type_index = TypeIndex::Build(index_entries);
+
+    auto resolve = [&](uint32_t type_ref) -> Type* {
+      if (type_ref == metadata::kNoType) {
+        return nullptr;
+      }
+
+      if ((type_ref & metadata::kExternalType) == 0) {
+        return type_ref < local_types.size() ? local_types[type_ref] : nullptr;
+      }
+
+      uint32_t idx = type_ref & ~metadata::kExternalType;
+      return idx < external_types.size() ? external_types[idx] : nullptr;
+    };
+
+    for (size_t i = 0; i < types.size(); ++i) {
+      const auto& record = types[i];
+      Type* type = local_types[i];
+      if (type == nullptr) {
+        DOTOTHER_LOG(DO_STR("  > Type failed to cache : [{}]"), MessageLevel::ERR, record.id);
+        continue;
+      }
+
+      /// published by an earlier load, or claimed by another import of the same assembly in this batch, its
+      ///   members are not ours to replace
+      if (!owned[i]) {
+        assembly.types.push_back(type);
+        continue;
+      }
+
+      type->base_type = resolve(record.base_type);
+      type->elt_type = resolve(record.element_type);
+
+      type->ancestors.clear();
+      type->ancestors.reserve(record.ancestors.count + 1);
+      for (uint32_t ancestor : type_refs.subspan(record.ancestors.first, record.ancestors.count)) {
+        type->ancestors.push_back(resolve(ancestor));
+      }
+      type->ancestors.push_back(type);
+
+      type->interface_bits.clear();
+      bool hierarchy_complete = std::ranges::find(type->ancestors, nullptr) == type->ancestors.end();
+      for (uint32_t iface_ref : type_refs.subspan(record.interfaces.first, record.interfaces.count)) {
+        Type* iface = resolve(iface_ref);
+        if (iface == nullptr) {
+          hierarchy_complete = false;
+          break;
+        }
+
+        uint32_t bit = TypeCache::Instance().InterfaceBit(*iface);
+        if (bit / 64 >= type->interface_bits.size()) {
+          type->interface_bits.resize(bit / 64 + 1, 0);
+        }
+        type->interface_bits[bit / 64] |= uint64_t{ 1 } << (bit % 64);
+      }
+
+      /// a hierarchy type that failed to cache would make native checks wrong, those types ask the runtime
+      if (!hierarchy_complete) {
+        type->ancestors.clear();
+        type->interface_bits.clear();
+      }
+
+      /// a bound image only vouches for the types, the members wait for their first use
+      if (binding != nullptr) {
+        type->binding = binding;
+        type->binding_record = static_cast<uint32_t>(i);
+      } else {
+        FillMembers(*type, record, resolve, id, true);
+        type->IndexMembers(MemberCategory::ALL);
+        std::atomic_ref(type->loaded).store(MemberCategory::ALL, std::memory_order_release);
+      }
+      assembly.types.push_back(type);
+    }
+
+    if (binding != nullptr) {
+      binding->locals = std::move(local_types);
+      binding->externals = std::move(external_types);
+    } else {
+      /// every attribute is already resolved, indexing does not call into managed. A bound image indexes on the
+      ///   first query instead, that is when its attributes are first used
+      assembly.IndexAttributes();
+    }
+
+    DOTOTHER_LOG(DO_STR(" > Imported [{}] types, [{}] methods, [{}] fields from metadata"), MessageLevel::TRACE,
+                 types.size(), Methods().size(), Fields().size());
+    return true;
+  }
+
+  ref<ImageBinding> ImageBinding::Bind(ref<MetadataImage> image, int32_t asm_id) {
+    ref<ImageBinding> binding{ new ImageBinding };
+    binding->handles.resize(image->RecordCount(), -1);
+
+    auto bytes = image->Bytes();
+    if (!Interop().bind_assembly_metadata(asm_id, bytes.data(), static_cast<int32_t>(bytes.size()), binding->handles.data(),
+                                          static_cast<int32_t>(binding->handles.size()))) {
+      return nullptr;
+    }
+
+    binding->image = std::move(image);
+    binding->asm_id = asm_id;
+    return binding;
+  }
+
+  bool ImageBinding::LoadMembers(Type& type, uint32_t record) {
+    auto types = image->Types();
+    auto externals = image->Externals();
+    if (record >= types.size() || locals.size() != types.size() || this->externals.size() != externals.size()) {
+      return false;
+    }
+
+    auto bytes = image->Bytes();
+    if (!Interop().bind_type_members(asm_id, bytes.data(), static_cast<int32_t>(bytes.size()), static_cast<int32_t>(record),
+                                     handles.data(), static_cast<int32_t>(handles.size()))) {
+      return false;
+    }
+
+    const size_t externals_base = types.size();
+    auto resolve = [&](uint32_t type_ref) -> Type* {
+      if (type_ref == metadata::kNoType) {
+        return nullptr;
+      }
+
+      if ((type_ref & metadata::kExternalType) == 0) {
+        return type_ref < locals.size() ? locals[type_ref] : nullptr;
+      }
+
+      uint32_t idx = type_ref & ~metadata::kExternalType;
+      if (idx >= this->externals.size()) {
+        return nullptr;
+      }
+
+      /// bound by this type's members, the import only cached the externals of the hierarchy
+      Type*& external = this->externals[idx];
+      if (external == nullptr && handles[externals_base + idx] != -1) {
+        external = TypeCache::Instance().CacheType(Type(handles[externals_base + idx]), image->String(externals[idx].full_name));
+      }
+      return external;
+    };
+
+    auto id = [&](size_t base, size_t idx, int32_t) {
+      return handles[base + idx];
+    };
+
+    image->FillMembers(type, types[record], resolve, id, false);
+    return true;
+  }
+
+}  // namespace dotother
@@ -0,0 +1,274 @@
+/**
+ * \file hosting/metadata_image.hpp
+ **/
+#ifndef DOTOTHER_METADATA_IMAGE_HPP
+#define DOTOTHER_METADATA_IMAGE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "core/dotother_defines.hpp"
+
+#include "hosting/type_cache.hpp"
+
+namespace dotother {
+
+  class Assembly;
+  class ImageBinding;
+  class Type;
+
+  namespace metadata {
+
+    /// binary layout shared with DotOther.Managed.MetadataExport, bump kVersion with any change
+    constexpr uint32_t kMagic = 0x444D4F44;  // 'DOMD'
+    constexpr uint32_t kVersion = 4;
+
+    /// a TypeRef indexes the image's own types, or with kExternalType set, the external types
+    constexpr uint32_t kNoType = 0xFFFFFFFF;
+    constexpr uint32_t kExternalType = 0x80000000;
+
+    enum TypeFlags : uint32_t {
+      SZ_ARRAY = 1 << 0,
+      VALUE_TYPE = 1 << 1,
+      ENUM = 1 << 2,
+      INTERFACE = 1 << 3,
+      ABSTRACT = 1 << 4,
+      GENERIC = 1 << 5,
+    };
+
+#pragma pack(push, 1)
+    /// what a cached image is valid for, the assembly's module version id and the runtime that reflected over it
+    struct CacheKey {
+      uint8_t mvid[16];
+      int32_t runtime_major;
+      int32_t runtime_minor;
+      int32_t runtime_build;
+
+      bool operator==(const CacheKey&) const = default;
+    };
+
+    struct Section {
+      uint32_t offset;
+      uint32_t count;
+    };
+
+    struct Range {
+      uint32_t first;
+      uint32_t count;
+    };
+
+    struct Header {
+      uint32_t magic;
+      uint32_t version;
+      uint32_t size;
+      int32_t asm_id;
+      uint32_t asm_name;
+      CacheKey key;
+      Section types;
+      Section externals;
+      Section methods;
+      Section fields;
+      Section properties;
+      Section attributes;
+      Section type_refs;
+      Section strings;
+    };
+
+    /// tokens are the metadata tokens of the reflected objects, Bind resolves a cached image's records through them
+    struct TypeRecord {
+      int32_t id;
+      int32_t token;
+      uint32_t name;
+      uint32_t full_name;
+      uint32_t nspace;
+      uint32_t base_type;
+      uint32_t element_type;
+      int32_t size;
+      int32_t managed_type;
+      uint32_t flags;
+      Range methods;
+      Range fields;
+      Range properties;
+      Range attributes;
+      /// type refs of the base type chain, root first, the type itself excluded
+      Range ancestors;
+      /// type refs of every interface the type implements, inherited ones included
+      Range interfaces;
+    };
+
+    struct ExternalTypeRecord {
+      int32_t id;
+      uint32_t full_name;
+      uint32_t asm_qualified_name;
+    };
+
+    /// members record the type declaring them, inherited members resolve their token in that type's module
+    struct MethodRecord {
+      int32_t id;
+      int32_t token;
+      uint32_t declaring_type;
+      uint32_t name;
+      uint32_t return_type;
+      Range params;
+      int32_t accessibility;
+      uint32_t is_static;
+      uint64_t signature;
+      Range attributes;
+    };
+
+    struct FieldRecord {
+      int32_t id;
+      int32_t token;
+      uint32_t declaring_type;
+      uint32_t name;
+      uint32_t type;
+      int32_t accessibility;
+      uint32_t is_static;
+      Range attributes;
+    };
+
+    struct PropertyRecord {
+      int32_t id;
+      int32_t token;
+      uint32_t declaring_type;
+      uint32_t name;
+      uint32_t type;
+    };
+
+    struct AttributeRecord {
+      int32_t id;
+      uint32_t type;
+    };
+#pragma pack(pop)
+
+    static_assert(sizeof(CacheKey) == 28, "Invalid size for metadata::CacheKey!");
+    static_assert(sizeof(Header) == 112, "Invalid size for metadata::Header!");
+    static_assert(sizeof(TypeRecord) == 88, "Invalid size for metadata::TypeRecord!");
+    static_assert(sizeof(MethodRecord) == 52, "Invalid size for metadata::MethodRecord!");
+    static_assert(sizeof(FieldRecord) == 36, "Invalid size for metadata::FieldRecord!");
+    static_assert(sizeof(PropertyRecord) == 20, "Invalid size for metadata::PropertyRecord!");
+
+  }  // namespace metadata
+
+  /// Read-only view over an assembly's metadata image. Every type, member, signature and name of the assembly
+  ///   arrives in one interop call instead of one call per member.
+  class MetadataImage {
+   public:
+    /// asks managed to serialize the assembly, returns null if the export failed or the image does not validate
+    static ref<MetadataImage> Export(int32_t asm_id);
+
+    /// takes ownership of an image already in memory
+    static ref<MetadataImage> FromBytes(std::vector<std::byte> bytes);
+
+    /// maps a cached image read-only, returns null if the file is missing or does not validate
+    static ref<MetadataImage> Map(const std::filesystem::path& path);
+
+    /// cache key of a loaded assembly, images are only reused under an equal key
+    static metadata::CacheKey Key(int32_t asm_id);
+
+    MetadataImage(const MetadataImage&) = delete;
+    MetadataImage& operator=(const MetadataImage&) = delete;
+    ~MetadataImage();
+
+    const metadata::Header& Header() const;
+    std::span<const std::byte> Bytes() const;
+
+    std::span<const metadata::TypeRecord> Types() const;
+    std::span<const metadata::ExternalTypeRecord> Externals() const;
+    std::span<const metadata::MethodRecord> Methods() const;
+    std::span<const metadata::FieldRecord> Fields() const;
+    std::span<const metadata::PropertyRecord> Properties() const;
+    std::span<const metadata::AttributeRecord> Attributes() const;
+    std::span<const uint32_t> TypeRefs() const;
+
+    std::string_view String(uint32_t offset) const;
+
+    /// number of ids an ImageBinding holds, one per type, external, member and attribute record
+    size_t RecordCount() const;
+
+    /// writes the image to a temporary file next to path and renames it into place
+    bool Save(const std::filesystem::path& path) const;
+
+    /// Builds the native Type objects of every type in the image and stages them in batch. Without a binding the
+    ///   recorded ids are this process's own and every member is filled right away. With one the image came from
+    ///   another process: types take the bound ids and their members bind on first use, see ImageBinding. Only
+    ///   types this import claims in the batch are filled, a type published earlier may be in use and keeps
+    ///   loading lazily
+    bool Import(Assembly& assembly, TypeCache::Batch& batch, const ref<ImageBinding>& binding = nullptr) const;
+
+   private:
+    MetadataImage() = default;
+
+    std::span<const std::byte> bytes;
+
+    /// exactly one of these backs bytes
+    void* hglobal = nullptr;
+    void* mapping = nullptr;
+    std::vector<std::byte> storage;
+
+    bool Validate() const;
+
+    /// positions of each record kind in an id list, types come first at 0
+    struct RecordBases {
+      size_t externals = 0;
+      size_t methods = 0;
+      size_t fields = 0;
+      size_t properties = 0;
+      size_t attributes = 0;
+    };
+
+    RecordBases Bases() const;
+
+    /// fills the methods, fields and properties of type from its record. id maps (record base, index, recorded id)
+    ///   to the id of this process, member attributes are filled only when with_attributes is set
+    template <typename Resolve, typename Id>
+    void FillMembers(Type& type, const metadata::TypeRecord& record, Resolve&& resolve, Id&& id, bool with_attributes) const;
+
+    friend class ImageBinding;
+
+    template <typename T>
+    std::span<const T> SectionSpan(const metadata::Section& section) const {
+      return { reinterpret_cast<const T*>(bytes.data() + section.offset), section.count };
+    }
+  };
+
+  /// Ids of this process for a cached image. The types and the types their hierarchy references bind when the
+  ///   assembly is imported, the members of a type the first time any of them is used, see Type::LoadMembers.
+  ///   Attributes are never bound from the image, they load through the regular calls on first use. Keeps the
+  ///   image mapped while a type still has members to bind.
+  class ImageBinding {
+   public:
+    /// resolves the type records of image against the loaded assembly, null when the image does not match it
+    static ref<ImageBinding> Bind(ref<MetadataImage> image, int32_t asm_id);
+
+    const MetadataImage& Image() const {
+      return *image;
+    }
+
+    /// binds and fills the methods, fields and properties of the type at record. False when they no longer
+    ///   resolve, type is left untouched then. Runs under the member load lock, which serializes every write to
+    ///   the ids and the external types
+    bool LoadMembers(Type& type, uint32_t record);
+
+   private:
+    ImageBinding() = default;
+
+    ref<MetadataImage> image = nullptr;
+    int32_t asm_id = -1;
+    /// one per record in MetadataImage::RecordCount order, -1 until bound
+    std::vector<int32_t> handles;
+    /// the cached Type of every type record and of every external bound so far, filled by MetadataImage::Import.
+    ///   An external only member signatures reference is cached when its first member binds
+    std::vector<Type*> locals;
+    std::vector<Type*> externals;
+
+    friend class MetadataImage;
+  };
+
+}  // namespace dotother
+
+#endif  // !DOTOTHER_METADATA_IMAGE_HPP
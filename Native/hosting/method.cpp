@@ -15,8 +15,13 @@ namespace dotother {
     // ParamTypes();
   }
 
-  NString Method::GetName() const {
-    return Interop().get_method_name(handle);
+  std::string_view Method::GetName() const {
+    return name;
+  }
+
+  void Method::LoadName() {
+    NString managed_name = Interop().get_method_name(handle);
+    name = NString::Intern(managed_name);
   }
 
   Type& Method::GetReturnType() {
@@ -29,13 +34,14 @@ namespace dotother {
   }
 
   const std::vector<Type*>& Method::ParamTypes() {
-    if (param_types.size() > 0) {
+    if (params_loaded) {
       return param_types;
     }
 
     int32_t count = 0;
     Interop().get_method_param_types(handle, nullptr, &count);
 
+    params_loaded = true;
     if (count == 0) {
       return param_types;
     }
@@ -58,15 +64,25 @@ namespace dotother {
     return param_types.size();
   }
 
+  uint64_t Method::Signature() const {
+    return signature != 0 ?
+      signature :
+      Interop().get_method_signature(handle);
+  }
+
   TypeAccessibility Method::Accessibility() const {
     return Interop().get_method_accessibility(handle);
   }
 
   std::vector<Attribute> Method::Attributes() const {
+    if (attributes_loaded) {
+      return attributes;
+    }
+
     int32_t count = 0;
     Interop().get_method_attributes(handle, nullptr, &count);
 
-    std::vector<int32_t> handles{ count };
+    std::vector<int32_t> handles(count);
     Interop().get_method_attributes(handle, handles.data(), &count);
 
     std::vector<Attribute> res;
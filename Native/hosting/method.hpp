@@ -4,34 +4,52 @@
 #ifndef DOTOTHER_METHOD_HPP
 #define DOTOTHER_METHOD_HPP
 
+#include <string>
+#include <string_view>
 #include <vector>
 
+#include "hosting/attribute.hpp"
 #include "hosting/native_string.hpp"
 
 namespace dotother {
 
   class Type;
-  class Attribute;
 
   class Method {
    public:
     Method(int32_t handle);
 
-    NString GetName() const;
+    /// filled when the owning type loads its members, see Type::LoadMembers
+    std::string_view GetName() const;
     Type& GetReturnType();
     const std::vector<Type*>& ParamTypes();
 
     size_t Arity() const;
+
+    /// hash of the parameter list, equal to util::SignatureHash<Args...>() for a matching native call
+    uint64_t Signature() const;
     TypeAccessibility Accessibility() const;
     std::vector<Attribute> Attributes() const;
 
     int32_t handle = -1;
 
    private:
+    std::string_view name;
+    uint64_t signature = 0;
+
     Type* ret_type = nullptr;
     std::vector<Type*> param_types{};
+    bool params_loaded = false;
+
+    std::vector<Attribute> attributes;
+    bool attributes_loaded = false;
+
+    void LoadName();
 
     friend class Type;
+    friend class Assembly;
+    friend class MetadataImage;
+    friend class TypeCache;
   };
 
 }  // namespace dotother
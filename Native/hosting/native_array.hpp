@@ -0,0 +1,217 @@
+/**
+ * \file hosting/native_array.hpp
+ **/
+#ifndef DOTOTHER_NATIVE_ARRAY_HPP
+#define DOTOTHER_NATIVE_ARRAY_HPP
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <memory>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+#include "core/dotother_defines.hpp"
+
+#include "hosting/hosted_object.hpp"
+#include "hosting/memory.hpp"
+
+namespace dotother {
+
+  /// Contiguous array shared with the managed runtime, layout-compatible with DotOther.Managed.NArray<T>:
+  ///   { T* data, int32_t length, nbool32 owner }
+  ///
+  /// An owning array allocates from the HGlobal heap so either side can release it, and frees it when destroyed.
+  ///   A view (owner == false) never frees. Returning an owning array to the other side transfers ownership,
+  ///   call Release() before handing the buffer over if this side should no longer free it.
+  ///
+  /// Besides trivially copyable values, an array can hold HostedObjects, which is how managed returns arrays of
+  ///   objects. Each element owns its handle and an owning array destroys its elements, freeing the handles.
+  template <typename T>
+  class NArray {
+    static_assert(std::is_trivially_copyable_v<T> || std::same_as<T, HostedObject>,
+                  "NArray elements must be trivially copyable or HostedObjects to cross the boundary");
+    static_assert(alignof(T) <= alignof(std::max_align_t), "NArray elements can not be over-aligned, HGlobal storage only guarantees max_align_t");
+
+   public:
+    using value_type = T;
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    NArray() = default;
+
+    explicit NArray(size_t length) {
+      Allocate(length);
+    }
+
+    explicit NArray(std::span<const T> elements)
+      requires std::is_trivially_copyable_v<T>
+    {
+      Allocate(elements.size());
+      if (!elements.empty()) {
+        std::memcpy(data, elements.data(), elements.size_bytes());
+      }
+    }
+
+    NArray(std::initializer_list<T> elements)
+      requires std::is_trivially_copyable_v<T>
+        : NArray(std::span<const T>(elements.begin(), elements.size())) {}
+
+    ~NArray() {
+      Reset();
+    }
+
+    NArray(const NArray&) = delete;
+    NArray& operator=(const NArray&) = delete;
+
+    NArray(NArray&& other) noexcept
+        : data(std::exchange(other.data, nullptr)), length(std::exchange(other.length, 0)), owner(std::exchange(other.owner, false)) {}
+
+    NArray& operator=(NArray&& other) noexcept {
+      if (this != &other) {
+        Reset();
+        data = std::exchange(other.data, nullptr);
+        length = std::exchange(other.length, 0);
+        owner = std::exchange(other.owner, false);
+      }
+      return *this;
+    }
+
+    /// non-owning view over memory owned by someone else
+    static NArray View(T* elements, size_t count) {
+      NArray res;
+      res.data = elements;
+      res.length = static_cast<int32_t>(count);
+      res.owner = false;
+      return res;
+    }
+
+    static NArray View(std::span<T> elements) {
+      return View(elements.data(), elements.size());
+    }
+
+    NArray Clone() const
+      requires std::is_trivially_copyable_v<T>
+    {
+      return NArray(Span());
+    }
+
+    /// gives up ownership of the buffer without freeing it, the array becomes a view
+    T* Release() {
+      owner = false;
+      return data;
+    }
+
+    void Reset() {
+      if (owner && data != nullptr) {
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+          std::destroy_n(data, Size());
+        }
+        Memory::FreeHGlobal(data);
+      }
+      data = nullptr;
+      length = 0;
+      owner = false;
+    }
+
+    bool IsOwner() const {
+      return owner;
+    }
+
+    T* Data() {
+      return data;
+    }
+
+    const T* Data() const {
+      return data;
+    }
+
+    size_t Size() const {
+      return static_cast<size_t>(length);
+    }
+
+    bool Empty() const {
+      return length == 0;
+    }
+
+    T& operator[](size_t index) {
+      assert(index < Size() && "NArray index out of range!");
+      return data[index];
+    }
+
+    const T& operator[](size_t index) const {
+      assert(index < Size() && "NArray index out of range!");
+      return data[index];
+    }
+
+    std::span<T> Span() {
+      return { data, Size() };
+    }
+
+    std::span<const T> Span() const {
+      return { data, Size() };
+    }
+
+    std::span<T> Subspan(size_t offset, size_t count = std::dynamic_extent) {
+      return Span().subspan(offset, count);
+    }
+
+    std::span<const T> Subspan(size_t offset, size_t count = std::dynamic_extent) const {
+      return Span().subspan(offset, count);
+    }
+
+    operator std::span<T>() {
+      return Span();
+    }
+
+    operator std::span<const T>() const {
+      return Span();
+    }
+
+    iterator begin() {
+      return data;
+    }
+
+    iterator end() {
+      return data + length;
+    }
+
+    const_iterator begin() const {
+      return data;
+    }
+
+    const_iterator end() const {
+      return data + length;
+    }
+
+   private:
+    T* data = nullptr;
+    int32_t length = 0;
+    nbool32 owner = false;
+
+    void Allocate(size_t count) {
+      if (count == 0) {
+        return;
+      }
+
+      data = static_cast<T*>(Memory::AllocHGlobal(count * sizeof(T)));
+      assert(data != nullptr && "Failed to allocate NArray storage!");
+
+      if constexpr (std::is_trivially_copyable_v<T>) {
+        std::memset(data, 0, count * sizeof(T));
+      } else {
+        std::uninitialized_value_construct_n(data, count);
+      }
+      length = static_cast<int32_t>(count);
+      owner = true;
+    }
+  };
+
+  static_assert(sizeof(NArray<int32_t>) == sizeof(void*) + sizeof(int32_t) + sizeof(nbool32), "Invalid size for NArray!");
+
+}  // namespace dotother
+
+#endif  // !DOTOTHER_NATIVE_ARRAY_HPP
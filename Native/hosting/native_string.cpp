@@ -3,6 +3,7 @@
  */
 #include "hosting/native_string.hpp"
 
+#include "core/string_pool.hpp"
 #include "core/utilities.hpp"
 
 #include "hosting/memory.hpp"
@@ -29,6 +30,12 @@ namespace dotother {
     str.string = nullptr;
   }
 
+  std::string_view NString::Intern(NString& str) {
+    std::string converted = str;
+    Free(str);
+    return StringPool::Instance().Intern(converted);
+  }
+
   void NString::Assign(std::string_view str) {
     if (string != nullptr)
       Memory::FreeCoTaskMem(string);
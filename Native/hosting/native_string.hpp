@@ -18,6 +18,8 @@ namespace dotother {
     static NString New(const char* str);
     static NString New(std::string_view str);
     static void Free(NString& str);
+    /// copies str into the StringPool and frees it, the view lives as long as the host
+    static std::string_view Intern(NString& str);
 
     void Assign(std::string_view str);
 
@@ -0,0 +1,41 @@
+/**
+ * \file hosting/property.cpp
+ **/
+#include "hosting/property.hpp"
+
+#include "core/utilities.hpp"
+
+#include "hosting/interop_interface.hpp"
+#include "hosting/type.hpp"
+#include "hosting/type_cache.hpp"
+
+namespace dotother {
+
+  Property::Property(int32_t handle)
+      : handle(handle) {}
+
+  std::string_view Property::GetName() const {
+    return name;
+  }
+
+  void Property::LoadName() {
+    NString managed_name = Interop().get_property_name(handle);
+    name = NString::Intern(managed_name);
+  }
+
+  Type& Property::GetType() {
+    if (type == nullptr) {
+      Type prop_type;
+      Interop().get_property_type(handle, &prop_type.handle);
+      type = TypeCache::Instance().CacheType(std::forward<Type>(prop_type));
+
+      if (type == nullptr) {
+        DOTOTHER_LOG(DO_STR("Property::GetType: Failed to cache property type"), MessageLevel::ERR);
+        static Type null_type(-1);
+        return null_type;
+      }
+    }
+    return *type;
+  }
+
+}  // namespace dotother
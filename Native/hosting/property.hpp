@@ -5,14 +5,35 @@
 #define DOTOTHER_PROPERTY_HPP
 
 #include <cstdint>
+#include <string>
+#include <string_view>
+
+#include "hosting/native_string.hpp"
 
 namespace dotother {
 
+  class Type;
+
   class Property {
     public:
+      Property(int32_t handle);
+
+      /// filled when the owning type loads its members, see Type::LoadMembers
+      std::string_view GetName() const;
+      Type& GetType();
+
       int32_t handle = -1;
+
+    private:
+      std::string_view name;
+      Type* type = nullptr;
+
+      void LoadName();
+
+      friend class Type;
+      friend class MetadataImage;
   };
 
 } // namespace dotother
 
-#endif // !DOTOTHER_PROPERTY_HPP
\ No newline at end of file
+#endif // !DOTOTHER_PROPERTY_HPP
@@ -0,0 +1,90 @@
+/**
+ * \file hosting/startup_profile.cpp
+ **/
+#include "hosting/startup_profile.hpp"
+
+#include <spdlog/fmt/fmt.h>
+
+namespace dotother {
+
+  uint64_t StartupReport::TotalNs() const {
+    uint64_t total = 0;
+    for (const auto& phase : phases) {
+      total += phase.wall_ns;
+    }
+    return total;
+  }
+
+  uint64_t StartupReport::TotalInteropCalls() const {
+    uint64_t total = 0;
+    for (const auto& phase : phases) {
+      total += phase.interop_calls;
+    }
+    return total;
+  }
+
+  std::string StartupReport::ToJson() const {
+    std::string res = "{\"phases\":{";
+    for (size_t i = 0; i < phases.size(); ++i) {
+      const auto& phase = phases[i];
+      res += fmt::format("{}\"{}\":{{\"wall_ns\":{},\"runs\":{},\"interop_calls\":{}}}", i == 0 ? "" : ",",
+                         PhaseName(static_cast<StartupPhase>(i)), phase.wall_ns, phase.runs, phase.interop_calls);
+    }
+    res += fmt::format("}},\"total_ns\":{},\"interop_calls\":{}", TotalNs(), TotalInteropCalls());
+
+    if (has_managed) {
+      res += ",\"managed\":{";
+      for (size_t i = 0; i < managed_ns.size(); ++i) {
+        res += fmt::format("{}\"{}\":{}", i == 0 ? "" : ",", PhaseName(static_cast<ManagedPhase>(i)), managed_ns[i]);
+      }
+      res += "}";
+    }
+
+    res += "}";
+    return res;
+  }
+
+  StartupProfile& StartupProfile::Instance() {
+    static StartupProfile instance;
+    return instance;
+  }
+
+  StartupProfile::Scope::Scope(StartupPhase phase)
+      : phase(phase), start(std::chrono::steady_clock::now()) {
+    StartupProfile& profile = StartupProfile::Instance();
+    profile.open_scopes.fetch_add(1, std::memory_order_relaxed);
+    start_calls = profile.InteropCalls();
+  }
+
+  StartupProfile::Scope::~Scope() {
+    StartupProfile& profile = StartupProfile::Instance();
+    auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+
+    Counters& counters = profile.phases[static_cast<size_t>(phase)];
+    counters.wall_ns.fetch_add(static_cast<uint64_t>(elapsed.count()), std::memory_order_relaxed);
+    counters.runs.fetch_add(1, std::memory_order_relaxed);
+    counters.interop_calls.fetch_add(profile.InteropCalls() - start_calls, std::memory_order_relaxed);
+    profile.open_scopes.fetch_sub(1, std::memory_order_relaxed);
+  }
+
+  StartupReport StartupProfile::Report() const {
+    StartupReport report;
+    for (size_t i = 0; i < phases.size(); ++i) {
+      report.phases[i] = PhaseTiming{
+        .wall_ns = phases[i].wall_ns.load(std::memory_order_relaxed),
+        .runs = phases[i].runs.load(std::memory_order_relaxed),
+        .interop_calls = phases[i].interop_calls.load(std::memory_order_relaxed),
+      };
+    }
+    return report;
+  }
+
+  void StartupProfile::Reset() {
+    for (auto& phase : phases) {
+      phase.wall_ns.store(0, std::memory_order_relaxed);
+      phase.runs.store(0, std::memory_order_relaxed);
+      phase.interop_calls.store(0, std::memory_order_relaxed);
+    }
+  }
+
+}  // namespace dotother
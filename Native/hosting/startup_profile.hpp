@@ -0,0 +1,136 @@
+/**
+ * \file hosting/startup_profile.hpp
+ **/
+#ifndef DOTOTHER_STARTUP_PROFILE_HPP
+#define DOTOTHER_STARTUP_PROFILE_HPP
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace dotother {
+
+  /// native startup phases in the order the host runs them
+  enum class StartupPhase : uint8_t {
+    HOST_PATH,
+    CLR_FUNCTIONS,
+    INITIALIZE_HOST,
+    MANAGED_FUNCTIONS,
+    ENTRY_POINT,
+    LOAD_ASSEMBLY,
+    IMPORT_TYPES,
+    COUNT,
+  };
+
+  /// managed side of the startup, filled by DotOther.Managed.StartupTimings, keep both in sync
+  enum class ManagedPhase : uint8_t {
+    ENTRY_POINT,
+    NET_CORE_ASSEMBLIES,
+    LOAD_ASSEMBLY,
+    EXPORT_METADATA,
+    BIND_METADATA,
+    COUNT,
+  };
+
+  constexpr std::string_view PhaseName(StartupPhase phase) {
+    constexpr std::array<std::string_view, static_cast<size_t>(StartupPhase::COUNT)> names = {
+      "host_path", "clr_functions", "initialize_host", "managed_functions", "entry_point", "load_assembly", "import_types",
+    };
+    return phase < StartupPhase::COUNT ? names[static_cast<size_t>(phase)] : "unknown";
+  }
+
+  constexpr std::string_view PhaseName(ManagedPhase phase) {
+    constexpr std::array<std::string_view, static_cast<size_t>(ManagedPhase::COUNT)> names = {
+      "entry_point", "net_core_assemblies", "load_assembly", "export_metadata", "bind_metadata",
+    };
+    return phase < ManagedPhase::COUNT ? names[static_cast<size_t>(phase)] : "unknown";
+  }
+
+  struct PhaseTiming {
+    uint64_t wall_ns = 0;
+    /// times the phase ran, LoadAssembly and the import phases run once per call
+    uint32_t runs = 0;
+    /// calls made through Interop() while the phase ran, including those of worker threads it started
+    uint64_t interop_calls = 0;
+  };
+
+  struct StartupReport {
+    std::array<PhaseTiming, static_cast<size_t>(StartupPhase::COUNT)> phases{};
+    /// managed wall time per ManagedPhase, empty unless the report was taken with the managed breakdown
+    std::array<uint64_t, static_cast<size_t>(ManagedPhase::COUNT)> managed_ns{};
+    bool has_managed = false;
+
+    const PhaseTiming& operator[](StartupPhase phase) const {
+      return phases[static_cast<size_t>(phase)];
+    }
+
+    uint64_t TotalNs() const;
+    uint64_t TotalInteropCalls() const;
+
+    /// one flat object, phase names as keys, for performance runs to compare against their budgets
+    std::string ToJson() const;
+  };
+
+  /// Process-wide startup timings. Phases accumulate until Reset, so a run that loads assemblies in several
+  ///   calls reports their sum. Scopes are meant for the thread driving the startup, the interop counter is
+  ///   shared by every thread and only counts while a scope is open, steady state calls never touch it.
+  class StartupProfile {
+   public:
+    static StartupProfile& Instance();
+
+    class Scope {
+     public:
+      explicit Scope(StartupPhase phase);
+      ~Scope();
+
+      Scope(const Scope&) = delete;
+      Scope& operator=(const Scope&) = delete;
+
+     private:
+      StartupPhase phase;
+      std::chrono::steady_clock::time_point start;
+      uint64_t start_calls = 0;
+    };
+
+    /// called by Interop(), outside of a scope this is a relaxed load of a flag that is never written
+    void CountInteropCall() {
+      if (open_scopes.load(std::memory_order_relaxed) != 0) {
+        interop_calls.fetch_add(1, std::memory_order_relaxed);
+      }
+    }
+
+    uint64_t InteropCalls() const {
+      return interop_calls.load(std::memory_order_relaxed);
+    }
+
+    /// native phases only, see Host::GetStartupReport for the managed breakdown
+    StartupReport Report() const;
+    void Reset();
+
+   private:
+    StartupProfile() = default;
+    ~StartupProfile() = default;
+
+    StartupProfile(StartupProfile&&) = delete;
+    StartupProfile(const StartupProfile&) = delete;
+    StartupProfile& operator=(StartupProfile&&) = delete;
+    StartupProfile& operator=(const StartupProfile&) = delete;
+
+    struct Counters {
+      std::atomic<uint64_t> wall_ns = 0;
+      std::atomic<uint32_t> runs = 0;
+      std::atomic<uint64_t> interop_calls = 0;
+    };
+
+    std::array<Counters, static_cast<size_t>(StartupPhase::COUNT)> phases;
+    /// kept off the counter's cache line, every Interop() call reads it
+    alignas(64) std::atomic<uint32_t> open_scopes = 0;
+    alignas(64) std::atomic<uint64_t> interop_calls = 0;
+  };
+
+}  // namespace dotother
+
+#endif  // !DOTOTHER_STARTUP_PROFILE_HPP
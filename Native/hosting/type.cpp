@@ -3,11 +3,17 @@
  **/
 #include "hosting/type.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <span>
+
 #include "core/utilities.hpp"
 
 #include "hosting/attribute.hpp"
 #include "hosting/field.hpp"
 #include "hosting/interop_interface.hpp"
+#include "hosting/metadata_image.hpp"
 #include "hosting/method.hpp"
 #include "hosting/native_string.hpp"
 #include "hosting/property.hpp"
@@ -15,62 +21,128 @@
 
 namespace dotother {
 
+  namespace {
+
+    /// member loads are one-off and never nest, one lock for every type keeps Type movable
+    std::mutex member_load_mutex;
+
+    using GetMemberHandles = void (*)(int32_t, int32_t*, int32_t*);
+
+    template <typename T>
+    void LoadMemberHandles(int32_t type, GetMemberHandles get_handles, std::vector<T>& members) {
+      int32_t count = 0;
+      get_handles(type, nullptr, &count);
+      if (count <= 0) {
+        return;
+      }
+
+      std::vector<int32_t> handles(count);
+      get_handles(type, handles.data(), &count);
+
+      members.reserve(members.size() + handles.size());
+      for (auto h : handles) {
+        members.emplace_back(h);
+      }
+    }
+
+  }  // namespace
+
   void Type::Init() {
-    if (handle == -1 || initialized) {
+    Prefetch(MemberCategory::ALL);
+  }
+
+  void Type::Prefetch(MemberCategory categories) {
+    LoadMembers(categories & MemberCategory::METHODS);
+    LoadMembers(categories & MemberCategory::FIELDS);
+    LoadMembers(categories & MemberCategory::PROPERTIES);
+    LoadMembers(categories & MemberCategory::ATTRIBUTES);
+  }
+
+  bool Type::IsLoaded(MemberCategory categories) const {
+    /// atomic_ref can not wrap a const object before C++26, the load does not write
+    MemberCategory current = std::atomic_ref(const_cast<MemberCategory&>(loaded)).load(std::memory_order_acquire);
+    return (current & categories) == categories;
+  }
+
+  void Type::LoadMembers(MemberCategory category) {
+    if (handle == -1 || category == MemberCategory::NONE || IsLoaded(category)) {
       return;
     }
 
-    int32_t count = 0;
-    // methods
-    {
-      Interop().get_type_methods(handle, nullptr, &count);
-      std::vector<int32_t> handles;
-      handles.resize(count);
-      Interop().get_type_methods(handle, handles.data(), &count);
-
-      for (size_t i = 0; i < handles.size(); ++i) {
-        methods.emplace_back(Method(handles[i]));
-      }
+    /// another thread may have loaded the category while we waited, the members are published by the store below
+    std::scoped_lock lock(member_load_mutex);
+    if (IsLoaded(category)) {
+      return;
     }
 
-    /// fields
-    {
-      Interop().get_type_fields(handle, nullptr, &count);
-      std::vector<int32_t> handles;
-      handles.resize(count);
-      Interop().get_type_fields(handle, handles.data(), &count);
+    /// attributes load like any other type's, the image only carries the ids of the other categories
+    if (binding != nullptr && category != MemberCategory::ATTRIBUTES) {
+      constexpr MemberCategory kBound = MemberCategory::METHODS | MemberCategory::FIELDS | MemberCategory::PROPERTIES;
 
-      for (size_t i = 0; i < handles.size(); ++i) {
-        fields.emplace_back(Field(handles[i]));
+      ref<ImageBinding> members = std::move(binding);
+      binding = nullptr;
+      if (members->LoadMembers(*this, binding_record)) {
+        IndexMembers(kBound);
+        std::atomic_ref(loaded).store(loaded | kBound, std::memory_order_release);
+        return;
       }
+      DOTOTHER_LOG(DO_STR("Type::LoadMembers: cached members of {} did not bind, loading them one call at a time"),
+                   MessageLevel::WARNING, full_name);
     }
 
-    // properties
-    {
-      Interop().get_type_properties(handle, nullptr, &count);
-      std::vector<int32_t> handles;
-      handles.resize(count);
-      Interop().get_type_properties(handle, handles.data(), &count);
+    switch (category) {
+      case MemberCategory::METHODS:
+        LoadMemberHandles(handle, Interop().get_type_methods, methods);
+        for (auto& member : methods) {
+          member.LoadName();
+        }
+        break;
+      case MemberCategory::FIELDS:
+        LoadMemberHandles(handle, Interop().get_type_fields, fields);
+        for (auto& member : fields) {
+          member.LoadName();
+        }
+        break;
+      case MemberCategory::PROPERTIES:
+        LoadMemberHandles(handle, Interop().get_type_properties, properties);
+        for (auto& member : properties) {
+          member.LoadName();
+        }
+        break;
+      case MemberCategory::ATTRIBUTES:
+        LoadMemberHandles(handle, Interop().get_type_attributes, attributes);
+        break;
+      default:
+        DOTOTHER_LOG(DO_STR("Type::LoadMembers: expected a single member category, got {}"), MessageLevel::ERR, static_cast<uint8_t>(category));
+        return;
+    }
 
-      for (size_t i = 0; i < handles.size(); ++i) {
-        properties.emplace_back(Property(handles[i]));
+    IndexMembers(category);
+    std::atomic_ref(loaded).store(loaded | category, std::memory_order_release);
+  }
+
+  void Type::IndexMembers(MemberCategory categories) {
+    if ((categories & MemberCategory::METHODS) != MemberCategory::NONE) {
+      method_index.clear();
+      for (uint32_t i = 0; i < methods.size(); ++i) {
+        method_index[methods[i].GetName()].push_back(i);
       }
     }
 
-    // attributes
-    {
-      Interop().get_type_attributes(handle, nullptr, &count);
-      std::vector<int32_t> handles;
-      handles.resize(count);
-      Interop().get_type_attributes(handle, handles.data(), &count);
-
-      for (size_t i = 0; i < handles.size(); ++i) {
-        attributes.emplace_back(handles[i]);
+    if ((categories & MemberCategory::FIELDS) != MemberCategory::NONE) {
+      field_index.clear();
+      for (uint32_t i = 0; i < fields.size(); ++i) {
+        field_index.try_emplace(fields[i].GetName(), i);
       }
     }
 
-    initialized = true;
-    DOTOTHER_LOG(DO_STR("Type::Init: Initialized type: {}"), MessageLevel::TRACE, FullName());
+    /// a property hidden with 'new' shows up once per declaring type, the most derived one comes first
+    if ((categories & MemberCategory::PROPERTIES) != MemberCategory::NONE) {
+      property_index.clear();
+      for (uint32_t i = 0; i < properties.size(); ++i) {
+        property_index.try_emplace(properties[i].GetName(), i);
+      }
+    }
   }
 
   Type& Type::BaseObject() {
@@ -88,35 +160,138 @@ namespace dotother {
   }
 
   bool Type::DerivedFrom(const Type& type) {
-    return Interop().is_type_derived_from(handle, type.handle);
+    if (ancestors.empty()) {
+      return Interop().is_type_derived_from(handle, type.handle);
+    }
+    return Subclasses(type);
   }
 
   bool Type::AssignableTo(const Type& type) {
-    return Interop().is_assignable_to(handle, type.handle);
+    if (ancestors.empty()) {
+      return Interop().is_assignable_to(handle, type.handle);
+    }
+    return ConvertsTo(type);
   }
 
   bool Type::AssignableFrom(const Type& type) {
-    return Interop().is_assignable_from(handle, type.handle);
+    if (type.ancestors.empty()) {
+      return Interop().is_assignable_from(handle, type.handle);
+    }
+    return type.ConvertsTo(*this);
+  }
+
+  bool Type::Subclasses(const Type& type) const {
+    /// a type at depth d can only be derived from through ancestors[d]
+    if (!type.ancestors.empty()) {
+      size_t depth = type.ancestors.size() - 1;
+      return depth + 1 < ancestors.size() && ancestors[depth]->handle == type.handle;
+    }
+
+    /// the chain is complete, a base without a display of its own is still found in it
+    auto bases = std::span(ancestors).first(ancestors.size() - 1);
+    return std::ranges::any_of(bases, [&](const Type* base) { return base->handle == type.handle; });
+  }
+
+  bool Type::ConvertsTo(const Type& type) const {
+    if (type.handle == handle || Subclasses(type) || Implements(type)) {
+      return true;
+    }
+
+    /// generic variance and Nullable<T> lifting only apply to constructed generic targets
+    std::string_view target = type.FullName();
+    if (target.find('`') != std::string_view::npos) {
+      return Interop().is_assignable_to(handle, type.handle);
+    }
+
+    /// interfaces have no base type but still convert to object
+    return target == "System.Object";
+  }
+
+  bool Type::Implements(const Type& iface) const {
+    int32_t bit = std::atomic_ref(const_cast<int32_t&>(iface.interface_bit)).load(std::memory_order_acquire);
+    if (bit < 0) {
+      return false;
+    }
+
+    size_t word = static_cast<size_t>(bit) / 64;
+    return word < interface_bits.size() && (interface_bits[word] >> (bit % 64) & 1) != 0;
   }
 
   std::vector<Method>& Type::Methods() {
+    LoadMembers(MemberCategory::METHODS);
     return methods;
   }
 
   std::vector<Field>& Type::Fields() {
+    LoadMembers(MemberCategory::FIELDS);
     return fields;
   }
 
   std::vector<Property>& Type::Properties() {
+    LoadMembers(MemberCategory::PROPERTIES);
     return properties;
   }
 
   std::vector<Attribute>& Type::Attributes() {
+    LoadMembers(MemberCategory::ATTRIBUTES);
     return attributes;
   }
 
+  Method* Type::FindMethod(std::string_view name, uint64_t signature) {
+    LoadMembers(MemberCategory::METHODS);
+
+    auto itr = method_index.find(name);
+    if (itr == method_index.end()) {
+      return nullptr;
+    }
+
+    for (uint32_t i : itr->second) {
+      if (methods[i].Signature() == signature) {
+        return &methods[i];
+      }
+    }
+
+    return nullptr;
+  }
+
+  std::vector<Method*> Type::FindOverloads(std::string_view name) {
+    LoadMembers(MemberCategory::METHODS);
+
+    std::vector<Method*> overloads;
+    if (auto itr = method_index.find(name); itr != method_index.end()) {
+      overloads.reserve(itr->second.size());
+      for (uint32_t i : itr->second) {
+        overloads.push_back(&methods[i]);
+      }
+    }
+
+    return overloads;
+  }
+
+  Field* Type::FindField(std::string_view name) {
+    LoadMembers(MemberCategory::FIELDS);
+
+    auto itr = field_index.find(name);
+    return itr != field_index.end() ? &fields[itr->second] : nullptr;
+  }
+
+  Property* Type::FindProperty(std::string_view name) {
+    LoadMembers(MemberCategory::PROPERTIES);
+
+    auto itr = property_index.find(name);
+    return itr != property_index.end() ? &properties[itr->second] : nullptr;
+  }
+
   bool Type::HasAttribute(const Type& type) {
-    return Interop().has_type_attribute(handle, type.handle);
+    if (!IsLoaded(MemberCategory::ATTRIBUTES)) {
+      return Interop().has_type_attribute(handle, type.handle);
+    }
+
+    /// matches Type.IsDefined, attributes deriving from type count
+    return std::ranges::any_of(attributes, [&](Attribute& attr) {
+      Type& attr_type = attr.GetType();
+      return attr_type.handle == type.handle || attr_type.DerivedFrom(type);
+    });
   }
 
   ManagedType Type::GetManagedType() {
@@ -137,6 +312,27 @@ namespace dotother {
     return *elt_type;
   }
 
+  Type* Type::MakeGeneric(std::span<const Type* const> args) {
+    std::vector<int32_t> arg_ids;
+    arg_ids.reserve(args.size());
+    for (const Type* arg : args) {
+      if (arg == nullptr || arg->handle == -1) {
+        DOTOTHER_LOG(DO_STR("Type::MakeGeneric: argument {} of {} is not a valid type"), MessageLevel::ERR, arg_ids.size(), FullName());
+        return nullptr;
+      }
+      arg_ids.push_back(arg->handle);
+    }
+
+    /// managed logs why an instantiation failed
+    Type generic;
+    Interop().make_generic_type(handle, arg_ids.data(), static_cast<int32_t>(arg_ids.size()), &generic.handle);
+    if (generic.handle == -1) {
+      return nullptr;
+    }
+
+    return TypeCache::Instance().CacheType(std::move(generic));
+  }
+
   bool Type::operator==(const Type& other) {
     return handle == other.handle;
   }
@@ -145,13 +341,39 @@ namespace dotother {
     return handle != -1;
   }
 
-  NString Type::FullName() {
-    return Interop().get_full_type_name(handle);
+  std::string_view Type::FullName() const {
+    if (full_name.empty()) {
+      NString managed_name = Interop().get_full_type_name(handle);
+      full_name = NString::Intern(managed_name);
+    }
+    return full_name;
+  }
+
+  size_t Type::MemoryUsage() const {
+    size_t bytes = sizeof(Type);
+
+    /// names are views into the StringPool, which accounts for them once
+
+    bytes += methods.capacity() * sizeof(Method);
+    for (const auto& method : methods) {
+      bytes += method.param_types.capacity() * sizeof(Type*);
+    }
+
+    bytes += fields.capacity() * sizeof(Field);
+    bytes += properties.capacity() * sizeof(Property);
+    bytes += attributes.capacity() * sizeof(Attribute);
+    bytes += ancestors.capacity() * sizeof(Type*) + interface_bits.capacity() * sizeof(uint64_t);
+
+    for (const auto& [_, overloads] : method_index) {
+      bytes += overloads.capacity() * sizeof(uint32_t) + sizeof(std::pair<const std::string_view, std::vector<uint32_t>>);
+    }
+    bytes += (field_index.size() + property_index.size()) * sizeof(std::pair<const std::string_view, uint32_t>);
+    return bytes;
   }
 
-  HostedObject Type::New(const void** argv, const ManagedType* arg_ts, size_t argc) {
+  HostedObject Type::New(const void** argv, uint64_t signature, size_t argc) {
     HostedObject res;
-    res.managed_handle = Interop().create_object(handle, false, argv, arg_ts, argc);
+    res.managed_handle = Interop().create_object(handle, false, argv, signature, argc);
     res.type = this;
     return res;
   }
@@ -160,12 +382,12 @@ namespace dotother {
     if (t == nullptr) {
       return "(null-type)";
     }
-    std::string name = t->FullName();
+    std::string_view name = t->FullName();
 
-    auto fields = t->Fields();
-    auto properties = t->Properties();
-    auto methods = t->Methods();
-    auto attributes = t->Attributes();
+    const auto& fields = t->Fields();
+    const auto& properties = t->Properties();
+    const auto& methods = t->Methods();
+    const auto& attributes = t->Attributes();
 
     std::stringstream ss;
     std::stringstream fieldss;
@@ -192,7 +414,7 @@ namespace dotother {
     fieldss << "              ";
 
     methodss << "\n";
-    for (auto& method : methods) {
+    for (const auto& method : methods) {
       methodss << fmt::format("                Method : {}\n"sv, method.GetName());
     }
     methodss << "              ";
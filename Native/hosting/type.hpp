@@ -4,7 +4,13 @@
 #ifndef DOTOTHER_TYPE_HPP
 #define DOTOTHER_TYPE_HPP
 
+#include <atomic>
 #include <cstdint>
+#include <initializer_list>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -21,6 +27,25 @@
 namespace dotother {
 
   class Host;
+  class ImageBinding;
+
+  /// groups of members a Type loads from managed, each one is fetched the first time it is asked for
+  enum class MemberCategory : uint8_t {
+    NONE = 0,
+    METHODS = 1 << 0,
+    FIELDS = 1 << 1,
+    PROPERTIES = 1 << 2,
+    ATTRIBUTES = 1 << 3,
+    ALL = METHODS | FIELDS | PROPERTIES | ATTRIBUTES,
+  };
+
+  constexpr MemberCategory operator|(MemberCategory lhs, MemberCategory rhs) {
+    return static_cast<MemberCategory>(static_cast<uint8_t>(lhs) | static_cast<uint8_t>(rhs));
+  }
+
+  constexpr MemberCategory operator&(MemberCategory lhs, MemberCategory rhs) {
+    return static_cast<MemberCategory>(static_cast<uint8_t>(lhs) & static_cast<uint8_t>(rhs));
+  }
 
   class Type {
    public:
@@ -29,12 +54,19 @@ namespace dotother {
         : handle(handle) {}
     ~Type() = default;
 
+    /// loads every member category, prefer Prefetch with only the categories needed
     void Init();
 
+    /// eagerly loads the given member categories, for hot types whose members should not be fetched mid-frame
+    void Prefetch(MemberCategory categories);
+    bool IsLoaded(MemberCategory categories) const;
+
     Type& BaseObject();
 
     int32_t TypeSize();
 
+    /// answered natively for types imported from a metadata image, see ancestors, other types ask the runtime.
+    ///   Expects types handed out by the TypeCache
     bool DerivedFrom(const Type& type);
     bool AssignableTo(const Type& type);
     bool AssignableFrom(const Type& type);
@@ -44,6 +76,17 @@ namespace dotother {
     std::vector<Method>& Methods();
     std::vector<Attribute>& Attributes();
 
+    /// overload of name whose signature matches, see util::SignatureHash, null if there is none
+    Method* FindMethod(std::string_view name, uint64_t signature);
+    template <typename... Args>
+    Method* FindMethod(std::string_view name) {
+      return FindMethod(name, util::SignatureHash<Args...>());
+    }
+    /// every overload of name, in declaration order
+    std::vector<Method*> FindOverloads(std::string_view name);
+    Field* FindField(std::string_view name);
+    Property* FindProperty(std::string_view name);
+
     bool HasAttribute(const Type& type);
 
     ManagedType GetManagedType();
@@ -51,42 +94,84 @@ namespace dotother {
     bool IsArray();
     Type& GetEltType();
 
+    /// closes this generic definition over args, e.g. List`1 over Vec3. The result is a normal cached type,
+    ///   repeated instantiations come from the managed cache. Null if the definition or arguments do not fit
+    Type* MakeGeneric(std::span<const Type* const> args);
+    Type* MakeGeneric(std::initializer_list<const Type*> args) {
+      return MakeGeneric(std::span(args.begin(), args.size()));
+    }
+
     bool operator==(const Type& other);
     operator bool();
 
-    NString FullName();
+    /// interned, see StringPool
+    std::string_view FullName() const;
+
+    /// bytes owned by this type and its loaded members, for cache accounting
+    size_t MemoryUsage() const;
 
     template <typename... Args>
     HostedObject NewInstance(Args&&... args) {
       constexpr size_t argc = sizeof...(args);
+      constexpr uint64_t signature = util::SignatureHash<Args...>();
 
       HostedObject res;
       if constexpr (argc > 0) {
         const void* argv[argc] = {};
-        ManagedType arg_ts[argc] = {};
-        util::AddToArray<Args...>(argv, arg_ts, std::forward<Args>(args)..., std::make_index_sequence<argc>{});
-        res = New(argv, arg_ts, argc);
+        util::AddToArray<Args...>(argv, std::forward<Args>(args)..., std::make_index_sequence<argc>{});
+        res = New(argv, signature, argc);
       } else {
-        res = New(nullptr, nullptr, 0);
+        res = New(nullptr, signature, 0);
       }
 
       return res;
     }
 
-    HostedObject New(const void** argv, const ManagedType* arg_ts, size_t argc);
+    HostedObject New(const void** argv, uint64_t signature, size_t argc);
 
     int32_t handle = -1;
 
    private:
-    bool initialized = false;
+    /// read and published through std::atomic_ref, see LoadMembers
+    alignas(std::atomic_ref<MemberCategory>::required_alignment) MemberCategory loaded = MemberCategory::NONE;
     Type* base_type = nullptr;
     Type* elt_type = nullptr;
+    mutable std::string_view full_name;
+
+    /// class display: the base type chain root first and the type itself last, so the ancestor at depth d is
+    ///   ancestors[d]. Empty when the type was not imported from a metadata image
+    std::vector<Type*> ancestors;
+    /// bit TypeCache::InterfaceBit(i) is set for every interface i the type implements
+    std::vector<uint64_t> interface_bits;
+    /// -1 until a type implementing this interface is imported. Assigned under the cache writer lock while other
+    ///   threads may test it, read and published through std::atomic_ref like loaded
+    alignas(std::atomic_ref<int32_t>::required_alignment) int32_t interface_bit = -1;
+
+    /// set while the methods, fields and properties of a type imported from a cached image are still unbound,
+    ///   the first load of any of them binds all three, see ImageBinding. Set before the type is published, only
+    ///   touched under the member load lock after that
+    ref<ImageBinding> binding = nullptr;
+    uint32_t binding_record = 0;
 
     std::vector<Field> fields;
     std::vector<Property> properties;
     std::vector<Method> methods;
     std::vector<Attribute> attributes;
 
+    /// member name => position in the member vectors, built when the category loads
+    template <typename V>
+    using NameIndex = std::unordered_map<std::string_view, V, util::StringHash, std::equal_to<>>;
+
+    NameIndex<std::vector<uint32_t>> method_index;
+    NameIndex<uint32_t> field_index;
+    NameIndex<uint32_t> property_index;
+
+    void LoadMembers(MemberCategory category);
+    void IndexMembers(MemberCategory category);
+    /// native halves of DerivedFrom/AssignableTo, only valid while ancestors is filled
+    bool Subclasses(const Type& type) const;
+    bool ConvertsTo(const Type& type) const;
+    bool Implements(const Type& iface) const;
     void CheckHost();
     void LoadTag();
 
@@ -98,6 +183,8 @@ namespace dotother {
     friend class Property;
     friend class Attribute;
     friend class Method;
+    friend class MetadataImage;
+    friend class TypeCache;
   };
 
   std::string FormatType(Type* t);
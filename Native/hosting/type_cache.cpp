@@ -4,7 +4,10 @@
 #include "hosting/type_cache.hpp"
 
 #include <sstream>
+#include <tuple>
+#include <unordered_set>
 
+#include "core/string_pool.hpp"
 #include "core/utilities.hpp"
 
 #include "hosting/attribute.hpp"
@@ -21,38 +24,162 @@ namespace dotother {
   }
 
   Type* TypeCache::CacheType(Type&& type) {
+    if (Type* cached = FindType(type.handle); cached != nullptr) {
+      hits.fetch_add(1, std::memory_order_relaxed);
+      return cached;
+    }
+
+    std::string_view full_name = type.FullName();
+    return CacheType(std::move(type), full_name);
+  }
+
+  Type* TypeCache::CacheType(Type&& type, std::string_view full_name, std::string_view nspace, int32_t asm_id) {
+    std::scoped_lock lock(write_mutex);
+    Writers writers{ IdMap::Writer(id_cache), NameMap::Writer(name_cache), QualifiedMap::Writer(qualified_cache) };
+    return CacheLocked(writers, std::move(type), full_name, nspace, asm_id);
+  }
+
+  std::vector<Type*> TypeCache::CacheTypes(std::span<const PendingType> pending) {
+    std::vector<Type*> res;
+    res.reserve(pending.size());
+
+    std::scoped_lock lock(write_mutex);
+    Writers writers{ IdMap::Writer(id_cache), NameMap::Writer(name_cache), QualifiedMap::Writer(qualified_cache) };
+    for (const auto& p : pending) {
+      res.push_back(CacheLocked(writers, Type(p.handle), p.full_name, p.nspace, p.asm_id));
+    }
+
+    return res;
+  }
+
+  std::vector<Type*> TypeCache::CacheTypes(std::span<const PendingType> pending, Batch& batch, std::vector<bool>* owned) {
+    std::vector<Type*> res;
+    res.reserve(pending.size());
+    if (owned != nullptr) {
+      owned->assign(pending.size(), false);
+    }
+
+    StringPool& pool = StringPool::Instance();
+
+    std::scoped_lock lock(write_mutex);
+    for (size_t i = 0; i < pending.size(); ++i) {
+      const auto& p = pending[i];
+      std::string_view full_name = pool.Intern(p.full_name);
+      std::string_view nspace = pool.Intern(p.nspace);
+
+      Type* t = id_cache.Find(p.handle);
+      if (t != nullptr) {
+        hits.fetch_add(1, std::memory_order_relaxed);
+      } else {
+        /// another import of the batch may have staged it first, as a type it references
+        auto [itr, inserted] = batch.staged.try_emplace(p.handle);
+        Batch::Staged& staged = itr->second;
+        if (inserted) {
+          misses.fetch_add(1, std::memory_order_relaxed);
+          staged.type = &types.Insert(Type(p.handle)).second;
+          staged.type->full_name = full_name;
+        } else {
+          hits.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        if (owned != nullptr && p.asm_id != -1 && !staged.owned) {
+          staged.owned = true;
+          (*owned)[i] = true;
+        }
+        t = staged.type;
+      }
+
+      /// published entries are recorded too, Publish qualifies them for this assembly like CacheLocked would
+      batch.entries.push_back({ t, full_name, nspace, p.asm_id });
+      res.push_back(t);
+    }
+
+    return res;
+  }
+
+  void TypeCache::Publish(Batch& batch) {
+    std::scoped_lock lock(write_mutex);
+    {
+      Writers writers{ IdMap::Writer(id_cache), NameMap::Writer(name_cache), QualifiedMap::Writer(qualified_cache) };
+      for (const auto& entry : batch.entries) {
+        /// a load outside the batch may have published the handle meanwhile, its entry stays the cached one
+        if (writers.ids.Find(entry.type->handle) == nullptr) {
+          writers.names.Insert(entry.full_name, entry.type);
+          writers.ids.Insert(entry.type->handle, entry.type);
+        }
+        Qualify(writers, entry.type, entry.full_name, entry.nspace, entry.asm_id);
+      }
+    }
+
+    batch.staged.clear();
+    batch.entries.clear();
+  }
+
+  Type* TypeCache::CacheLocked(Writers& writers, Type&& type, std::string_view full_name, std::string_view nspace, int32_t asm_id) {
+    /// callers may pass transient views, every key the cache stores points into the pool
+    full_name = StringPool::Instance().Intern(full_name);
+    nspace = StringPool::Instance().Intern(nspace);
+
+    if (Type* cached = writers.ids.Find(type.handle); cached != nullptr) {
+      hits.fetch_add(1, std::memory_order_relaxed);
+      /// may have been seen as another assembly's member type before its own assembly loaded
+      Qualify(writers, cached, full_name, nspace, asm_id);
+      return cached;
+    }
+    misses.fetch_add(1, std::memory_order_relaxed);
+
     Type* t = &types.Insert(std::move(type)).second;
     if (t == nullptr) {
       DOTOTHER_LOG(DO_STR("TypeCache::CacheType: Failed to cache type"), MessageLevel::ERR);
       return nullptr;
     }
-    t->Init();
+    t->full_name = full_name;
+    /// members are loaded per category on first use, see Type::LoadMembers
 
-    DOTOTHER_LOG(DO_STR("TypeCache::CacheType: Caching type {}"), MessageLevel::TRACE, type.FullName());  // , FormatType(t));
+    DOTOTHER_LOG(DO_STR("TypeCache::CacheType: Caching type {}"), MessageLevel::TRACE, full_name);  // , FormatType(t));
 
-    std::string name = t->FullName();
-    name_cache[name] = t;
-    id_cache[t->handle] = t;
+    writers.names.Insert(full_name, t);
+    writers.ids.Insert(t->handle, t);
+    Qualify(writers, t, full_name, nspace, asm_id);
     return t;
   }
 
+  void TypeCache::Qualify(Writers& writers, Type* type, std::string_view full_name, std::string_view nspace, int32_t asm_id) {
+    if (asm_id == -1) {
+      return;
+    }
+
+    /// the key name is the full name past the namespace and its dot, so nested types keep their declaring type.
+    ///   A namespace that is not a dotted prefix of the full name leaves the name whole
+    std::string_view name = full_name;
+    if (!nspace.empty() && full_name.size() > nspace.size() + 1 && full_name.starts_with(nspace) &&
+        full_name[nspace.size()] == '.') {
+      name = full_name.substr(nspace.size() + 1);
+    }
+
+    TypeKeyView view{ asm_id, nspace, name };
+    if (writers.qualified.Find(view) != nullptr) {
+      return;
+    }
+
+    writers.qualified.Insert(TypeKey{ asm_id, nspace, name, view.Hash() }, type);
+  }
+
   Type* TypeCache::GetType(const std::string_view name) {
-    auto name_str = std::string(name);
-    bool contains = name_cache.contains(name_str);
-    if (contains) {
-      Type* t = name_cache[name_str];
+    return name_cache.Find(name);
+  }
 
-      DOTOTHER_LOG(DO_STR("TypeCache::GetType: Found type"), MessageLevel::TRACE);  // , FormatType(t));
-      return t;
+  Type* TypeCache::GetType(const TypeKeyView& key) const {
+    TypeKeyView lookup = key;
+    if (lookup.nspace.empty()) {
+      std::tie(lookup.nspace, lookup.name) = util::SplitTypeName(key.name);
     }
 
-    return nullptr;
+    return qualified_cache.Find(lookup);
   }
 
   Type* TypeCache::GetType(int32_t id) {
-    bool contains = id_cache.contains(id);
-    if (contains) {
-      Type* t = id_cache[id];
+    if (Type* t = id_cache.Find(id); t != nullptr) {
       DOTOTHER_LOG(DO_STR("TypeCache::GetType: Found type with ID [{}]"), MessageLevel::TRACE, id);  // , FormatType(t));
       return t;
     }
@@ -61,4 +188,119 @@ namespace dotother {
     return nullptr;
   }
 
+  Type* TypeCache::FindType(int32_t id) const {
+    return id_cache.Find(id);
+  }
+
+  void TypeCache::Evict(std::span<const int32_t> ids) {
+    std::scoped_lock lock(write_mutex);
+
+    std::unordered_set<Type*> evicted;
+    {
+      Writers writers{ IdMap::Writer(id_cache), NameMap::Writer(name_cache), QualifiedMap::Writer(qualified_cache) };
+      for (int32_t id : ids) {
+        Type* t = writers.ids.Find(id);
+        if (t == nullptr) {
+          continue;
+        }
+
+        writers.ids.Erase(id);
+        /// another context may have cached a type under the same name since, only drop our own entry
+        if (writers.names.Find(t->full_name) == t) {
+          writers.names.Erase(t->full_name);
+        }
+        evicted.insert(t);
+      }
+
+      if (evicted.empty()) {
+        return;
+      }
+
+      std::vector<TypeKey> stale;
+      qualified_cache.ForEach([&](const TypeKey& key, Type* t) {
+        if (evicted.contains(t)) {
+          stale.push_back(key);
+        }
+      });
+
+      for (const auto& key : stale) {
+        writers.qualified.Erase(key);
+      }
+    }
+
+    /// attribute ids die with their context, their cached values go with the types that carried them
+    std::vector<int32_t> attribute_ids;
+    auto collect = [&](const std::vector<Attribute>& attributes) {
+      for (const auto& attribute : attributes) {
+        attribute_ids.push_back(attribute.handle);
+      }
+    };
+
+    for (Type* t : evicted) {
+      collect(t->attributes);
+      for (const auto& method : t->methods) {
+        collect(method.attributes);
+      }
+      for (const auto& field : t->fields) {
+        collect(field.attributes);
+      }
+      Invalidate(*t);
+    }
+    Attribute::EvictSnapshots(attribute_ids);
+
+    DOTOTHER_LOG(DO_STR("TypeCache::Evict: evicted [{}] types"), MessageLevel::TRACE, evicted.size());
+  }
+
+  void TypeCache::Invalidate(Type& type) {
+    type.handle = -1;
+    type.base_type = nullptr;
+    type.elt_type = nullptr;
+    type.ancestors.clear();
+    type.interface_bits.clear();
+    type.binding = nullptr;
+
+    type.fields.clear();
+    type.properties.clear();
+    type.methods.clear();
+    type.attributes.clear();
+    type.method_index.clear();
+    type.field_index.clear();
+    type.property_index.clear();
+
+    /// nothing left to load, a stale pointer sees an empty type instead of calling into managed with handle -1
+    type.loaded = MemberCategory::ALL;
+  }
+
+  uint32_t TypeCache::InterfaceBit(Type& iface) {
+    std::scoped_lock lock(write_mutex);
+    /// writers are serialized, only Type::Implements reads the bit without the lock
+    std::atomic_ref bit(iface.interface_bit);
+    if (bit.load(std::memory_order_relaxed) < 0) {
+      bit.store(static_cast<int32_t>(next_interface_bit++), std::memory_order_release);
+    }
+    return static_cast<uint32_t>(bit.load(std::memory_order_relaxed));
+  }
+
+  TypeCacheStats TypeCache::Stats() const {
+    /// holds writers off so every cached type is fully constructed while it is measured
+    std::scoped_lock lock(write_mutex);
+
+    TypeCacheStats stats{
+      .entries = types.Size(),
+      .name_bytes = StringPool::Instance().Bytes(),
+      .hits = hits.load(std::memory_order_relaxed),
+      .misses = misses.load(std::memory_order_relaxed),
+    };
+
+    for (size_t i = 0; i < types.Size(); ++i) {
+      stats.bytes += types[i].MemoryUsage();
+    }
+
+    stats.bytes += name_cache.Size() * sizeof(std::pair<const std::string_view, Type*>);
+    stats.bytes += qualified_cache.Size() * sizeof(std::pair<const TypeKey, Type*>);
+    stats.bytes += id_cache.Size() * sizeof(std::pair<const int32_t, Type*>);
+
+    return stats;
+  }
+
 }  // namespace dotother
\ No newline at end of file
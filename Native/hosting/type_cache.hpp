@@ -4,23 +4,170 @@
 #ifndef DOTOTHER_TYPE_CACHED_HPP
 #define DOTOTHER_TYPE_CACHED_HPP
 
+#include <atomic>
+#include <mutex>
+#include <span>
 #include <string>
 #include <string_view>
 #include <unordered_map>
+#include <vector>
 
+#include "core/snapshot_map.hpp"
 #include "core/stable_vector.hpp"
+#include "core/utilities.hpp"
 
 namespace dotother {
 
   class Type;
 
+  struct TypeCacheStats {
+    size_t entries = 0;
+    /// heap owned by cached types, their members and the name index
+    size_t bytes = 0;
+    /// heap owned by the StringPool, shared by every type and member name
+    size_t name_bytes = 0;
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+
+    double HitRate() const {
+      uint64_t lookups = hits + misses;
+      return lookups == 0 ? 0.0 : static_cast<double>(hits) / static_cast<double>(lookups);
+    }
+  };
+
+  /// (assembly, namespace, name) a type is registered under, name keeps any nested/generic suffix
+  struct TypeKeyView {
+    int32_t asm_id = -1;
+    std::string_view nspace;
+    std::string_view name;
+
+    /// a zero byte closes the namespace, no type name contains one, so moving a segment across the split
+    ///   ("A.B", "C") vs ("A", "B.C") changes the hash
+    constexpr uint64_t Hash() const {
+      uint64_t hash = util::HashCombine(util::HashString(nspace), uint8_t{ 0 });
+      return util::HashCombine(util::HashString(name, hash), asm_id);
+    }
+
+    constexpr bool operator==(const TypeKeyView&) const = default;
+  };
+
+  /// stored key, the names are interned and the hash is computed once when the type is cached
+  struct TypeKey {
+    int32_t asm_id = -1;
+    std::string_view nspace;
+    std::string_view name;
+    uint64_t hash = 0;
+
+    TypeKeyView View() const {
+      return { asm_id, nspace, name };
+    }
+  };
+
+  struct TypeKeyHash {
+    using is_transparent = void;
+
+    size_t operator()(const TypeKey& key) const {
+      return static_cast<size_t>(key.hash);
+    }
+
+    size_t operator()(const TypeKeyView& key) const {
+      return static_cast<size_t>(key.Hash());
+    }
+  };
+
+  struct TypeKeyEqual {
+    using is_transparent = void;
+
+    bool operator()(const TypeKey& lhs, const TypeKey& rhs) const {
+      return lhs.hash == rhs.hash && lhs.View() == rhs.View();
+    }
+
+    bool operator()(const TypeKey& lhs, const TypeKeyView& rhs) const {
+      return lhs.View() == rhs;
+    }
+
+    bool operator()(const TypeKeyView& lhs, const TypeKey& rhs) const {
+      return lhs == rhs.View();
+    }
+  };
+
+  /// Safe for concurrent use. Lookups read published snapshots and never wait on writers, caching takes a writer
+  ///   lock and publishes once per call, cache a whole assembly with CacheTypes rather than one CacheType per type.
+  ///   Cached Types load each member category once, concurrent first uses wait for the same load.
   class TypeCache {
     public:
+      struct PendingType {
+        int32_t handle = -1;
+        std::string_view full_name;
+        std::string_view nspace;
+        int32_t asm_id = -1;
+      };
+
+      /// Types cached by a batch of imports. CacheTypes calls through the same batch find them, lookups do not
+      ///   until Publish makes the whole batch visible at once. A batch dropped unpublished leaves its types
+      ///   allocated but unreachable, like evicted ones. Only touched under the writer lock, so the imports of
+      ///   one batch may share it across threads
+      class Batch {
+        public:
+          Batch() = default;
+
+          Batch(Batch&&) = delete;
+          Batch(const Batch&) = delete;
+          Batch& operator=(Batch&&) = delete;
+          Batch& operator=(const Batch&) = delete;
+
+        private:
+          struct Entry {
+            Type* type = nullptr;
+            std::string_view full_name;
+            std::string_view nspace;
+            int32_t asm_id = -1;
+          };
+
+          struct Staged {
+            Type* type = nullptr;
+            bool owned = false;
+          };
+
+          std::unordered_map<int32_t, Staged> staged;
+          std::vector<Entry> entries;
+
+          friend class TypeCache;
+      };
+
       static TypeCache& Instance();
 
+      /// returns the cached entry when a type with the same handle exists, only unseen handles are stored
       Type* CacheType(Type&& type);
+      /// caches a type whose name is already known, skips the interop call for it. Types of a loaded assembly
+      ///   pass its id and namespace so they can be found per assembly, see GetType(TypeKeyView)
+      Type* CacheType(Type&& type, std::string_view full_name, std::string_view nspace = {}, int32_t asm_id = -1);
+      /// caches a batch under one writer lock and one publish, results line up with pending
+      std::vector<Type*> CacheTypes(std::span<const PendingType> pending);
+      /// stages into batch instead of publishing, handles already published resolve to their cached entry.
+      ///   owned marks the staged results this call is first to claim as types of their own assembly (asm_id set),
+      ///   only that importer fills their members
+      std::vector<Type*> CacheTypes(std::span<const PendingType> pending, Batch& batch, std::vector<bool>* owned = nullptr);
+      /// makes every type staged in batch visible under one writer lock and one publish, then empties it
+      void Publish(Batch& batch);
       Type* GetType(const std::string_view name);
       Type* GetType(int32_t name);
+      /// lookup scoped to one assembly, an empty namespace is split off the name
+      Type* GetType(const TypeKeyView& key) const;
+
+      /// same as GetType but quiet when the type is missing, for probing before caching
+      Type* FindType(int32_t id) const;
+
+      /// Forgets the types of an unloaded load context. The Type objects stay allocated so pointers still held
+      ///   elsewhere do not dangle, but they lose their handle and members and no lookup returns them again.
+      ///   The cached values of their attributes are dropped as well, see Attribute::EvictSnapshots.
+      ///   Callers must make sure nothing is using the evicted types while this runs.
+      void Evict(std::span<const int32_t> ids);
+
+      TypeCacheStats Stats() const;
+
+      /// dense bit of an interface type in Type::interface_bits, assigned the first time an implementer is imported
+      uint32_t InterfaceBit(Type& iface);
 
     private:
       TypeCache() = default;
@@ -31,11 +178,34 @@ namespace dotother {
       TypeCache& operator=(TypeCache&&) = delete;
       TypeCache& operator=(const TypeCache&) = delete;
 
+      using IdMap = SnapshotMap<int32_t, Type*>;
+      using NameMap = SnapshotMap<std::string_view, Type*, util::StringHash, std::equal_to<>>;
+      using QualifiedMap = SnapshotMap<TypeKey, Type*, TypeKeyHash, TypeKeyEqual>;
+
+      struct Writers {
+        IdMap::Writer ids;
+        NameMap::Writer names;
+        QualifiedMap::Writer qualified;
+      };
+
       StableVector<Type> types;
-      std::unordered_map<std::string, Type*> name_cache;
-      std::unordered_map<int32_t, Type*> id_cache;
+      IdMap id_cache;
+      NameMap name_cache;
+      QualifiedMap qualified_cache;
+
+      /// serializes writers, readers never take it
+      mutable std::mutex write_mutex;
+
+      std::atomic<uint64_t> hits = 0;
+      std::atomic<uint64_t> misses = 0;
+
+      uint32_t next_interface_bit = 0;
+
+      void Invalidate(Type& type);
+      Type* CacheLocked(Writers& writers, Type&& type, std::string_view full_name, std::string_view nspace, int32_t asm_id);
+      void Qualify(Writers& writers, Type* type, std::string_view full_name, std::string_view nspace, int32_t asm_id);
   };
 
 } // namespace dotother
 
-#endif // !DOTOTHER_TYPE_CACHED_HPP
\ No newline at end of file
+#endif // !DOTOTHER_TYPE_CACHED_HPP
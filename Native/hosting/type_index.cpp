@@ -0,0 +1,200 @@
+/**
+ * \file hosting/type_index.cpp
+ **/
+#include "hosting/type_index.hpp"
+
+#include <algorithm>
+#include <numeric>
+
+#include "core/utilities.hpp"
+
+namespace dotother {
+
+  namespace {
+
+    /// average number of names per bucket, lower builds faster, higher stores fewer seeds
+    constexpr size_t kBucketLoad = 4;
+
+    /// a bucket that can not be placed within this many seeds means two names share a 64-bit hash
+    constexpr uint32_t kMaxSeed = 1u << 20;
+
+    /// splitmix64 finalizer over the name hash and a bucket seed
+    constexpr uint64_t Mix(uint64_t hash, uint32_t seed) {
+      uint64_t x = hash ^ (static_cast<uint64_t>(seed) * 0x9E3779B97F4A7C15ull);
+      x ^= x >> 30;
+      x *= 0xBF58476D1CE4E5B9ull;
+      x ^= x >> 27;
+      x *= 0x94D049BB133111EBull;
+      x ^= x >> 31;
+      return x;
+    }
+
+  }  // namespace
+
+  TypeIndex TypeIndex::Build(std::span<const Entry> entries) {
+    TypeIndex index;
+    if (entries.empty()) {
+      return index;
+    }
+
+    const size_t count = entries.size();
+    const size_t bucket_count = (count + kBucketLoad - 1) / kBucketLoad;
+
+    std::vector<uint64_t> hashes(count);
+    std::vector<std::vector<uint32_t>> buckets(bucket_count);
+    for (size_t i = 0; i < count; ++i) {
+      hashes[i] = util::HashString(entries[i].full_name);
+      buckets[hashes[i] % bucket_count].push_back(static_cast<uint32_t>(i));
+    }
+
+    /// the largest buckets are placed first while most slots are still free
+    std::vector<uint32_t> order(bucket_count);
+    std::iota(order.begin(), order.end(), 0);
+    std::ranges::sort(order, [&](uint32_t lhs, uint32_t rhs) {
+      return buckets[lhs].size() > buckets[rhs].size();
+    });
+
+    index.seeds.assign(bucket_count, 0);
+    index.slots.resize(count);
+
+    std::vector<bool> taken(count, false);
+    std::vector<size_t> positions;
+    for (uint32_t b : order) {
+      const auto& bucket = buckets[b];
+      if (bucket.empty()) {
+        break;
+      }
+
+      uint32_t seed = 0;
+      for (; seed < kMaxSeed; ++seed) {
+        positions.clear();
+
+        bool placed = true;
+        for (uint32_t key : bucket) {
+          size_t pos = Mix(hashes[key], seed) % count;
+          if (taken[pos] || std::ranges::find(positions, pos) != positions.end()) {
+            placed = false;
+            break;
+          }
+          positions.push_back(pos);
+        }
+
+        if (placed) {
+          break;
+        }
+      }
+
+      if (seed == kMaxSeed) {
+        DOTOTHER_LOG(DO_STR("TypeIndex::Build: could not place [{}] names, duplicate full names?"), MessageLevel::ERR, bucket.size());
+        return TypeIndex{};
+      }
+
+      index.seeds[b] = seed;
+      for (size_t i = 0; i < bucket.size(); ++i) {
+        const Entry& entry = entries[bucket[i]];
+
+        taken[positions[i]] = true;
+        index.slots[positions[i]] = Slot{
+          .hash = hashes[bucket[i]],
+          .name_offset = static_cast<uint32_t>(index.names.size()),
+          .name_length = static_cast<uint32_t>(entry.full_name.size()),
+          .type = entry.type,
+        };
+        index.names += entry.full_name;
+      }
+    }
+
+    index.sorted.resize(count);
+    std::iota(index.sorted.begin(), index.sorted.end(), 0);
+    std::ranges::sort(index.sorted, [&](uint32_t lhs, uint32_t rhs) {
+      return index.Name(index.slots[lhs]) < index.Name(index.slots[rhs]);
+    });
+
+    return index;
+  }
+
+  Type* TypeIndex::Find(std::string_view full_name) const {
+    if (slots.empty()) {
+      return nullptr;
+    }
+
+    uint64_t hash = util::HashString(full_name);
+    const Slot* slot = Probe(hash);
+    return slot->hash == hash && Name(*slot) == full_name ?
+      slot->type :
+      nullptr;
+  }
+
+  Type* TypeIndex::Find(std::string_view nspace, std::string_view name) const {
+    if (nspace.empty()) {
+      return Find(name);
+    }
+
+    if (slots.empty()) {
+      return nullptr;
+    }
+
+    /// FNV-1a is incremental, hashing the pieces in order equals hashing "nspace.name"
+    uint64_t hash = util::HashString(name, util::HashString(".", util::HashString(nspace)));
+    const Slot* slot = Probe(hash);
+    if (slot->hash != hash) {
+      return nullptr;
+    }
+
+    std::string_view full_name = Name(*slot);
+    bool matches = full_name.size() == nspace.size() + 1 + name.size() &&
+                   full_name.starts_with(nspace) &&
+                   full_name[nspace.size()] == '.' &&
+                   full_name.ends_with(name);
+    return matches ? slot->type : nullptr;
+  }
+
+  std::vector<Type*> TypeIndex::WithPrefix(std::string_view prefix) const {
+    return Collect(prefix, [](std::string_view) { return true; });
+  }
+
+  std::vector<Type*> TypeIndex::InNamespace(std::string_view nspace) const {
+    return Collect(nspace, [nspace](std::string_view full_name) {
+      return util::SplitTypeName(full_name).first == nspace;
+    });
+  }
+
+  size_t TypeIndex::Size() const {
+    return slots.size();
+  }
+
+  bool TypeIndex::Empty() const {
+    return slots.empty();
+  }
+
+  std::string_view TypeIndex::Name(const Slot& slot) const {
+    return std::string_view(names).substr(slot.name_offset, slot.name_length);
+  }
+
+  const TypeIndex::Slot* TypeIndex::Probe(uint64_t hash) const {
+    uint32_t seed = seeds[hash % seeds.size()];
+    return &slots[Mix(hash, seed) % slots.size()];
+  }
+
+  template <typename Pred>
+  std::vector<Type*> TypeIndex::Collect(std::string_view prefix, Pred&& pred) const {
+    auto first = std::ranges::lower_bound(sorted, prefix, {}, [this](uint32_t slot) {
+      return Name(slots[slot]);
+    });
+
+    std::vector<Type*> res;
+    for (auto itr = first; itr != sorted.end(); ++itr) {
+      std::string_view full_name = Name(slots[*itr]);
+      if (!full_name.starts_with(prefix)) {
+        break;
+      }
+
+      if (pred(full_name)) {
+        res.push_back(slots[*itr].type);
+      }
+    }
+
+    return res;
+  }
+
+}  // namespace dotother
@@ -0,0 +1,69 @@
+/**
+ * \file hosting/type_index.hpp
+ **/
+#ifndef DOTOTHER_TYPE_INDEX_HPP
+#define DOTOTHER_TYPE_INDEX_HPP
+
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace dotother {
+
+  class Type;
+
+  /// Immutable index over the types of one assembly, built once when the assembly is loaded.
+  ///
+  /// Full names go through a minimal perfect hash (hash and displace): a name hashes to a bucket, the bucket's
+  ///   seed places it in exactly one slot, so a lookup is one hash and one compare. A name-sorted copy of the
+  ///   slots answers prefix and namespace queries.
+  class TypeIndex {
+   public:
+    struct Entry {
+      std::string_view full_name;
+      Type* type = nullptr;
+    };
+
+    TypeIndex() = default;
+
+    /// names are copied, entries must be unique by full name
+    static TypeIndex Build(std::span<const Entry> entries);
+
+    Type* Find(std::string_view full_name) const;
+    /// same as Find("nspace.name") without building the joined string
+    Type* Find(std::string_view nspace, std::string_view name) const;
+
+    /// types whose full name starts with prefix, in name order
+    std::vector<Type*> WithPrefix(std::string_view prefix) const;
+    /// types declared directly in nspace, nested namespaces excluded
+    std::vector<Type*> InNamespace(std::string_view nspace) const;
+
+    size_t Size() const;
+    bool Empty() const;
+
+   private:
+    struct Slot {
+      uint64_t hash = 0;
+      uint32_t name_offset = 0;
+      uint32_t name_length = 0;
+      Type* type = nullptr;
+    };
+
+    std::vector<uint32_t> seeds;
+    std::vector<Slot> slots;
+    /// slot indices ordered by full name
+    std::vector<uint32_t> sorted;
+    std::string names;
+
+    std::string_view Name(const Slot& slot) const;
+    const Slot* Probe(uint64_t hash) const;
+
+    template <typename Pred>
+    std::vector<Type*> Collect(std::string_view prefix, Pred&& pred) const;
+  };
+
+}  // namespace dotother
+
+#endif  // !DOTOTHER_TYPE_INDEX_HPP
@@ -8,6 +8,11 @@ using DotOther.Managed.Interop;
 
 namespace DotOther.Tests {
 
+  public class ScriptAttribute : Attribute {}
+
+  public sealed class BehaviourAttribute : ScriptAttribute {}
+
+  [Script]
   public class Mod1 : OtherObject {
     private Int32 my_num;
 
@@ -29,13 +34,17 @@ namespace DotOther.Tests {
       set => my_num = value;
     }
 
+    [Behaviour]
     public float number = 0.0f;
 
+    public Vec3 position = Vec3.zero;
+
     public Mod1() {
       Console.WriteLine($" Mod1 Asm Name : {this.GetType().AssemblyQualifiedName}");
       my_num = 0;
     }
 
+    [Script]
     public void Test() {
       Console.WriteLine("Mod1.Test");
     }
@@ -44,6 +53,24 @@ namespace DotOther.Tests {
       Console.WriteLine("Mod1.Test: " + num);
     }
 
+    [Behaviour]
+    public void Move(Vec3 delta) {
+      position = new Vec3(position.x + delta.x, position.y + delta.y, position.z + delta.z);
+      Console.WriteLine($"Mod1.Move: {position}");
+    }
+
+    public Int32 SumNums(Mod1 other) {
+      return my_num + other.my_num;
+    }
+
+    public Mod1 Self() {
+      return this;
+    }
+
+    public Mod1[] Pair(Mod1 other) {
+      return new[] { this, other };
+    }
+
     public void TestInternalCall() {
       Console.WriteLine("Mod1.TestInternalCall");
       unsafe {
@@ -55,6 +82,16 @@ namespace DotOther.Tests {
     private static unsafe delegate*<IntPtr> GetVec3;
   }
 
+  public class Box<T> {
+    public T value;
+  }
+
+  [Behaviour]
+  public class Both<TFirst, TSecond> {
+    public TFirst first;
+    public TSecond second;
+  }
+
   [StructLayout(LayoutKind.Sequential , Size = 12)]
   public struct Vec3 : IEquatable<Vec3> {
     public static Vec3 zero = new Vec3(0.0f, 0.0f , 0.0f);
@@ -1,6 +1,7 @@
 /**
  * \file Native/specialized_tests/host_tests.cpp
  **/
+#include <algorithm>
 #include <filesystem>
 #include <print>
 
@@ -15,7 +16,10 @@
 #include "hosting/host.hpp"
 #include "hosting/interop_interface.hpp"
 #include "hosting/method.hpp"
+#include "hosting/native_array.hpp"
 #include "hosting/native_object.hpp"
+#include "hosting/startup_profile.hpp"
+#include "hosting/type_cache.hpp"
 #include "reflection/object_proxy.hpp"
 
 using namespace dotother;
@@ -23,6 +27,14 @@ using namespace dotother::literals;
 
 using namespace std::string_view_literals;
 
+struct Vec3 {
+  float x;
+  float y;
+  float z;
+};
+
+DOTOTHER_MANAGED_STRUCT(Vec3, "DotOther.Tests.Vec3");
+
 class HostTests : public DoTest {
  public:
  protected:
@@ -31,6 +43,7 @@ class HostTests : public DoTest {
     .managed_asm_path = DO_STR("./bin/Debug/DotOther.Managed/net8.0/DotOther.Managed.dll"),
     .dotnet_type = DO_STR("DotOther.Managed.DotOtherHost, DotOther.Managed"),
     .entry_point = DO_STR("EntryPoint"),
+    .metadata_cache_path = std::filesystem::temp_directory_path() / "dotother_host_tests",
 
     .exception_callback = [](const NString message) {
         DOTOTHER_LOG(DO_STR("C# Exception Caught : \n\t{}"sv), MessageLevel::DEBUG, message);
@@ -51,6 +64,9 @@ class HostTests : public DoTest {
   // static inline glm::vec3 vec = glm::vec3(1.f, 2.f, 3.f);  // , 4.f);
 
   virtual void SetUp() {
+    /// the first load of Mod1 exports and caches its image, later loads bind the cached one
+    std::filesystem::remove_all(config.metadata_cache_path);
+
     host = Host::Instance(config);
     ASSERT_NO_THROW(host->LoadHost());
     ASSERT_NO_THROW(host->CallEntryPoint());
@@ -96,8 +112,16 @@ TEST_F(HostTests, load_asm_and_call_functions) {
 
   std::filesystem::path mod1_path = "./bin/Debug/DotOther.Tests/net8.0/Mod1.dll";
 
+  /// managed time spent in a phase so far, phases accumulate over the whole process
+  auto managed_ns = [&](ManagedPhase phase) {
+    return host->GetStartupReport(true).managed_ns[static_cast<size_t>(phase)];
+  };
+
   ref<Assembly> assembly = nullptr;
+  const uint64_t export_start = managed_ns(ManagedPhase::EXPORT_METADATA);
   ASSERT_NO_THROW(assembly = asm_ctx.LoadAssembly(mod1_path.string()));
+  const uint64_t export_ns = managed_ns(ManagedPhase::EXPORT_METADATA) - export_start;
+  ASSERT_GT(export_ns, 0);
   ASSERT_NE(assembly, nullptr);
   ASSERT_NE(assembly->GetId(), -1);
 
@@ -107,6 +131,81 @@ TEST_F(HostTests, load_asm_and_call_functions) {
   Type& type = assembly->GetType("DotOther.Tests.Mod1");
   ASSERT_NE(type.handle, -1);
 
+  /// members arrive with the assembly's metadata image, nothing is fetched lazily
+  ASSERT_TRUE(type.IsLoaded(MemberCategory::ALL));
+  Method* move = type.FindMethod<Vec3>("Move");
+  ASSERT_NE(move, nullptr);
+  ASSERT_EQ(move->GetName(), "Move");
+  ASSERT_EQ(type.FindMethod<int32_t>("Move"), nullptr);
+  ASSERT_EQ(type.FindOverloads("Test").size(), 2);
+  ASSERT_NE(type.FindProperty("MyInt"), nullptr);
+
+  /// subtype checks against the imported hierarchy
+  Type& other_object = type.BaseObject();
+  ASSERT_TRUE(type.DerivedFrom(other_object));
+  ASSERT_TRUE(type.AssignableTo(other_object));
+  ASSERT_TRUE(other_object.AssignableFrom(type));
+  ASSERT_FALSE(type.DerivedFrom(type));
+  ASSERT_FALSE(other_object.DerivedFrom(type));
+
+  /// caching a known handle hands back the canonical entry
+  ASSERT_EQ(TypeCache::Instance().CacheType(Type(type.handle)), &type);
+
+  /// closed generics are cached types like any other, the same arguments give back the same entry
+  Type& vec3 = assembly->GetType("DotOther.Tests.Vec3");
+  Type& box = assembly->GetType("DotOther.Tests.Box`1");
+  Type& both = assembly->GetType("DotOther.Tests.Both`2");
+  ASSERT_NE(vec3.handle, -1);
+  ASSERT_NE(box.handle, -1);
+  ASSERT_NE(both.handle, -1);
+
+  Type* box_vec3 = box.MakeGeneric({ &vec3 });
+  ASSERT_NE(box_vec3, nullptr);
+  ASSERT_TRUE(box_vec3->FullName().starts_with("DotOther.Tests.Box`1[[DotOther.Tests.Vec3"));
+  ASSERT_EQ(box.MakeGeneric({ &vec3 }), box_vec3);
+
+  Type* both_mod1_vec3 = both.MakeGeneric({ &type, &vec3 });
+  ASSERT_NE(both_mod1_vec3, nullptr);
+  ASSERT_TRUE(both_mod1_vec3->FullName().starts_with("DotOther.Tests.Both`2[[DotOther.Tests.Mod1"));
+  ASSERT_NE(both_mod1_vec3, box_vec3);
+  ASSERT_EQ(both.MakeGeneric({ &type, &vec3 }), both_mod1_vec3);
+
+  ASSERT_EQ(box.MakeGeneric({ &vec3, &vec3 }), nullptr);
+  ASSERT_EQ(both.MakeGeneric({ &vec3 }), nullptr);
+  ASSERT_EQ(type.MakeGeneric({ &vec3 }), nullptr);
+  ASSERT_EQ(box.MakeGeneric({ nullptr }), nullptr);
+
+  /// attribute queries match derived attributes, BehaviourAttribute derives from ScriptAttribute
+  Type& script = assembly->GetType("DotOther.Tests.ScriptAttribute");
+  Type& behaviour = assembly->GetType("DotOther.Tests.BehaviourAttribute");
+  ASSERT_NE(script.handle, -1);
+  ASSERT_NE(behaviour.handle, -1);
+  ASSERT_TRUE(type.HasAttribute(script));
+  ASSERT_FALSE(type.HasAttribute(behaviour));
+  ASSERT_TRUE(both.HasAttribute(script));
+
+  auto has = [](const auto& targets, const auto* target) {
+    return std::ranges::find(targets, target) != targets.end();
+  };
+
+  std::vector<Type*> script_types = asm_ctx.FindTypesWithAttribute(script);
+  ASSERT_EQ(script_types.size(), 2);
+  ASSERT_TRUE(has(script_types, &type));
+  ASSERT_TRUE(has(script_types, &both));
+  ASSERT_EQ(asm_ctx.FindTypesWithAttribute(behaviour), std::vector<Type*>{ &both });
+
+  std::vector<Method*> script_methods = asm_ctx.FindMethodsWithAttribute(script);
+  ASSERT_EQ(script_methods.size(), 2);
+  ASSERT_TRUE(has(script_methods, type.FindMethod("Test")));
+  ASSERT_TRUE(has(script_methods, move));
+  ASSERT_EQ(asm_ctx.FindMethodsWithAttribute(behaviour), std::vector<Method*>{ move });
+
+  std::vector<Field*> behaviour_fields = asm_ctx.FindFieldsWithAttribute(behaviour);
+  ASSERT_EQ(behaviour_fields.size(), 1);
+  ASSERT_EQ(behaviour_fields[0]->GetName(), "number");
+  ASSERT_EQ(asm_ctx.FindFieldsWithAttribute(script), behaviour_fields);
+  ASSERT_TRUE(asm_ctx.FindFieldsWithAttribute(vec3).empty());
+
   DOTOTHER_LOG(DO_STR("Creating Instance Type: {}"sv), MessageLevel::DEBUG, type.FullName());
   HostedObject obj;
   ASSERT_NO_FATAL_FAILURE(obj = type.NewInstance());
@@ -131,7 +230,97 @@ TEST_F(HostTests, load_asm_and_call_functions) {
   ASSERT_EQ(number, expected);
   DOTOTHER_LOG(DO_STR("Property Value: {}"sv), MessageLevel::DEBUG, number);
 
+  Vec3 position{};
+  ASSERT_NO_FATAL_FAILURE(obj.SetField("position", Vec3{ 1.f, 2.f, 3.f }));
+  ASSERT_NO_FATAL_FAILURE(obj.Invoke<void>("Move", Vec3{ 1.f, 1.f, 1.f }));
+  ASSERT_NO_FATAL_FAILURE(position = obj.GetField<Vec3>("position"sv));
+  ASSERT_EQ(position.x, 2.f);
+  ASSERT_EQ(position.y, 3.f);
+  ASSERT_EQ(position.z, 4.f);
+
+  HostedObject other;
+  ASSERT_NO_FATAL_FAILURE(other = type.NewInstance());
+  ASSERT_NO_FATAL_FAILURE(other.SetProperty("MyNum", 3));
+  ASSERT_NO_FATAL_FAILURE(obj.SetProperty("MyNum", 4));
+
+  int32_t sum = 0;
+  ASSERT_NO_FATAL_FAILURE(sum = obj.Invoke<int32_t>("SumNums", other));
+  ASSERT_EQ(sum, 7);
+
+  HostedObject self;
+  ASSERT_NO_FATAL_FAILURE(self = obj.Invoke<HostedObject>("Self"));
+  ASSERT_TRUE(self.IsValid());
+  ASSERT_EQ(self.GetProperty<int32_t>("MyNum"sv), 4);
+
+  /// every returned object is a handle of its own, dropping the HostedObject frees it
+  for (int32_t i = 0; i < 16; ++i) {
+    HostedObject tmp = obj.Invoke<HostedObject>("Self");
+    ASSERT_TRUE(tmp.IsValid());
+  }
+  self.Destroy();
+  ASSERT_FALSE(self.IsValid());
+  ASSERT_EQ(obj.GetProperty<int32_t>("MyNum"sv), 4);
+
+  /// object arrays arrive as owning handles, the array frees them when it goes away
+  {
+    NArray<HostedObject> pair;
+    ASSERT_NO_FATAL_FAILURE(pair = obj.Invoke<NArray<HostedObject>>("Pair", other));
+    ASSERT_EQ(pair.Size(), 2);
+    ASSERT_TRUE(pair.IsOwner());
+    ASSERT_EQ(pair[0].GetProperty<int32_t>("MyNum"sv), 4);
+    ASSERT_EQ(pair[1].GetProperty<int32_t>("MyNum"sv), 3);
+  }
+
+  /// members inherited from the shared base are reflected through Mod1, their ids belong to Mod1's context
+  Method* inherited = type.FindMethod("GetHashCode");
+  ASSERT_NE(inherited, nullptr);
+  const int32_t inherited_id = inherited->handle;
+  const int32_t base_id = other_object.handle;
+
   ASSERT_NO_THROW(host->UnloadAssemblyContext(asm_ctx));
+
+  /// the inherited member went with the context, the shared base type stays cached
+  NString stale_name = Interop().get_method_name(inherited_id);
+  ASSERT_EQ(NString::Intern(stale_name), "");
+  ASSERT_EQ(TypeCache::Instance().FindType(base_id), &other_object);
+
+  /// batch loads report a status per file, only the files that loaded join the context
+  AssemblyContext batch_ctx;
+  ASSERT_NO_THROW(batch_ctx = host->CreateAsmContext("Batch"));
+
+  const std::string mod1 = mod1_path.string();
+  const std::string_view paths[] = { mod1, "./bin/Debug/DotOther.Tests/net8.0/Missing.dll"sv };
+  std::vector<ref<Assembly>> batch;
+  const uint64_t reexport_start = managed_ns(ManagedPhase::EXPORT_METADATA);
+  const uint64_t bind_start = managed_ns(ManagedPhase::BIND_METADATA);
+  ASSERT_NO_THROW(batch = batch_ctx.LoadAssemblies(paths));
+  ASSERT_EQ(batch.size(), 2);
+  ASSERT_EQ(batch[0]->LoadStatus(), AssemblyLoadStatus::SUCCESS);
+  ASSERT_EQ(batch[1]->LoadStatus(), AssemblyLoadStatus::FILE_NOT_FOUND);
+  ASSERT_NE(batch[0]->GetType("DotOther.Tests.Mod1").handle, -1);
+
+  /// Mod1 was cached by the first load, this one bound the type records by token and leaves the members of
+  ///   each type until they are first used
+  ASSERT_FALSE(std::filesystem::is_empty(config.metadata_cache_path));
+  Type& cached_type = batch[0]->GetType("DotOther.Tests.Mod1");
+  ASSERT_FALSE(cached_type.IsLoaded(MemberCategory::METHODS));
+  Method* cached_move = cached_type.FindMethod<Vec3>("Move");
+  ASSERT_NE(cached_move, nullptr);
+  ASSERT_EQ(cached_move->GetName(), "Move");
+  ASSERT_TRUE(cached_type.IsLoaded(MemberCategory::METHODS | MemberCategory::FIELDS | MemberCategory::PROPERTIES));
+  ASSERT_NE(cached_type.FindMethod("GetHashCode"), nullptr);
+  ASSERT_NE(cached_type.FindProperty("MyInt"), nullptr);
+  ASSERT_EQ(cached_move->Attributes().size(), 1);
+
+  /// the hit exported nothing, binding the types and Mod1's members cost less than the export of the first load
+  const uint64_t bind_ns = managed_ns(ManagedPhase::BIND_METADATA) - bind_start;
+  ASSERT_EQ(managed_ns(ManagedPhase::EXPORT_METADATA), reexport_start);
+  ASSERT_GT(bind_ns, 0);
+  ASSERT_LT(bind_ns, export_ns);
+  ASSERT_EQ(batch_ctx.GetAssemblies().size(), 1);
+  ASSERT_EQ(batch_ctx.GetAssemblies()[0], batch[0]);
+
+  ASSERT_NO_THROW(host->UnloadAssemblyContext(batch_ctx));
 }
 
 #ifdef DOTOTHER_WINDOWS
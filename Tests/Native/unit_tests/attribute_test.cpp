@@ -0,0 +1,100 @@
+/**
+ * \file Native/unit_tests/attribute_test.cpp
+ **/
+#include "core/dotest.hpp"
+
+#include <bit>
+#include <cstring>
+#include <string_view>
+#include <vector>
+
+#include "hosting/attribute.hpp"
+#include <gtest.h>
+
+using namespace dotother;
+
+class AttributeTests : public DoTest {
+  public:
+  protected:
+    virtual void SetUp() override {}
+    virtual void TearDown() override {}
+
+    /// two records, Order = -3 and Category = "Physics", laid out the way AttributeSnapshot.Build writes them
+    static std::vector<std::byte> MakeSnapshot() {
+      using namespace attribute_snapshot;
+
+      std::vector<std::byte> strings;
+      auto intern = [&](std::string_view str) {
+        uint32_t offset = static_cast<uint32_t>(strings.size());
+        uint32_t length = static_cast<uint32_t>(str.size());
+        strings.resize(strings.size() + sizeof(length) + str.size());
+        std::memcpy(strings.data() + offset, &length, sizeof(length));
+        std::memcpy(strings.data() + offset + sizeof(length), str.data(), str.size());
+        return offset;
+      };
+
+      Record records[] = {
+        { .name = intern("Order"), .kind = static_cast<int32_t>(ManagedType::INT), .value = static_cast<uint64_t>(int64_t{ -3 }) },
+        { .name = intern("Category"), .kind = static_cast<int32_t>(ManagedType::STRING), .value = 0 },
+      };
+      records[1].value = intern("Physics");
+
+      Header header{
+        .size = static_cast<uint32_t>(sizeof(Header) + sizeof(records) + strings.size()),
+        .count = 2,
+        .strings = static_cast<uint32_t>(sizeof(Header) + sizeof(records)),
+        .reserved = 0,
+      };
+
+      std::vector<std::byte> block(header.size);
+      std::memcpy(block.data(), &header, sizeof(header));
+      std::memcpy(block.data() + sizeof(header), records, sizeof(records));
+      std::memcpy(block.data() + header.strings, strings.data(), strings.size());
+      return block;
+    }
+};
+
+TEST_F(AttributeTests, values_convert_only_to_their_kind) {
+  AttributeValue order{ .name = "Order", .kind = ManagedType::INT, .bits = static_cast<uint64_t>(int64_t{ -3 }) };
+  EXPECT_EQ(order.As<int32_t>(), -3);
+  EXPECT_EQ(order.As<int64_t>(), std::nullopt);
+  EXPECT_EQ(order.As<std::string_view>(), std::nullopt);
+
+  AttributeValue speed{ .name = "Speed", .kind = ManagedType::FLOAT, .bits = std::bit_cast<uint32_t>(2.5f) };
+  EXPECT_EQ(speed.As<float>(), 2.5f);
+  EXPECT_EQ(speed.As<double>(), std::nullopt);
+
+  AttributeValue enabled{ .name = "Enabled", .kind = ManagedType::BOOL, .bits = 1 };
+  EXPECT_EQ(enabled.As<bool>(), true);
+
+  AttributeValue category{ .name = "Category", .kind = ManagedType::STRING, .string = "Physics" };
+  EXPECT_EQ(category.As<std::string_view>(), "Physics");
+  EXPECT_EQ(category.As<int32_t>(), std::nullopt);
+}
+
+TEST_F(AttributeTests, read_snapshot) {
+  std::vector<AttributeValue> values = Attribute::ReadSnapshot(MakeSnapshot());
+  ASSERT_EQ(values.size(), 2);
+
+  EXPECT_EQ(values[0].name, "Order");
+  EXPECT_EQ(values[0].As<int32_t>(), -3);
+
+  EXPECT_EQ(values[1].name, "Category");
+  EXPECT_EQ(values[1].kind, ManagedType::STRING);
+  EXPECT_EQ(values[1].As<std::string_view>(), "Physics");
+}
+
+TEST_F(AttributeTests, read_snapshot_rejects_malformed) {
+  std::vector<std::byte> block = MakeSnapshot();
+  EXPECT_TRUE(Attribute::ReadSnapshot(std::span(block).first(8)).empty());
+
+  /// the header size has to match the block
+  block.push_back(std::byte{ 0 });
+  EXPECT_TRUE(Attribute::ReadSnapshot(block).empty());
+
+  /// records may not run into the string table
+  block = MakeSnapshot();
+  uint32_t count = 3;
+  std::memcpy(block.data() + offsetof(attribute_snapshot::Header, count), &count, sizeof(count));
+  EXPECT_TRUE(Attribute::ReadSnapshot(block).empty());
+}
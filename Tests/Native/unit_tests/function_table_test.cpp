@@ -0,0 +1,33 @@
+/**
+ * \file Native/unit_tests/function_table_test.cpp
+ **/
+#include "core/dotest.hpp"
+
+#include <cstdint>
+
+#include "hosting/interop_interface.hpp"
+#include <gtest.h>
+
+using namespace dotother;
+using namespace dotother::interface_bindings;
+
+class FunctionTableTests : public DoTest {};
+
+TEST_F(FunctionTableTests, entry_tags_match_managed_field_names) {
+  EXPECT_EQ(EntryTag("load_assembly"), EntryTag("LoadAssembly"));
+  EXPECT_EQ(EntryTag("get_last_load_status"), EntryTag("GetLastLoadStatus"));
+  EXPECT_EQ(EntryTag("is_type_sz_array"), EntryTag("IsTypeSzArray"));
+  EXPECT_NE(EntryTag("load_assembly"), EntryTag("GetLastLoadStatus"));
+}
+
+TEST_F(FunctionTableTests, stamped_slots_carry_their_own_tag) {
+  FunctionTable table;
+  table.StampEntries();
+
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(table.load_assembly), EntryTag("LoadAssembly"));
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(table.get_last_load_status), EntryTag("GetLastLoadStatus"));
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(table.get_startup_timings), EntryTag("GetStartupTimings"));
+
+  /// a slot the bootstrap never overwrote still holds its tag, the table is not usable
+  EXPECT_FALSE(table.BoundToAsm());
+}
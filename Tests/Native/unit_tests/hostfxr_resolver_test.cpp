@@ -0,0 +1,62 @@
+/**
+ * \file Native/unit_tests/hostfxr_resolver_test.cpp
+ **/
+#include "core/dotest.hpp"
+
+#include <filesystem>
+#include <fstream>
+
+#include "hosting/hostfxr_resolver.hpp"
+#include <gtest.h>
+
+using namespace dotother;
+
+class HostFxrResolverTests : public DoTest {
+  public:
+  protected:
+    virtual void SetUp() override {
+      root = std::filesystem::temp_directory_path() / "dotother_fxr_test";
+      std::filesystem::remove_all(root);
+
+      for (auto version : { "8.0.1", "8.0.11", "8.0.12-preview.1", "9.0.0", "not-a-version" }) {
+        AddFxr(version);
+      }
+      /// a newer directory without the library is skipped
+      std::filesystem::create_directories(root / "host" / "fxr" / "8.1.0");
+    }
+
+    virtual void TearDown() override {
+      std::filesystem::remove_all(root);
+    }
+
+    void AddFxr(const char* version) {
+      std::filesystem::path dir = root / "host" / "fxr" / version;
+      std::filesystem::create_directories(dir);
+      std::ofstream(dir / DOTOTHER_HOSTFXR_NAME) << "";
+    }
+
+    std::filesystem::path root;
+};
+
+TEST_F(HostFxrResolverTests, version_order) {
+  auto release = FxrVersion::Parse("8.0.11");
+  auto preview = FxrVersion::Parse("8.0.11-rc.2");
+  ASSERT_TRUE(release.has_value() && preview.has_value());
+  EXPECT_LT(*preview, *release);
+  EXPECT_LT(*FxrVersion::Parse("8.0.2"), *FxrVersion::Parse("8.0.10"));
+  EXPECT_FALSE(FxrVersion::Parse("8.0").has_value());
+  EXPECT_FALSE(FxrVersion::Parse("8.0.1x").has_value());
+}
+
+TEST_F(HostFxrResolverTests, highest_matching_major) {
+  EXPECT_EQ(FindHostFxrInRoot(root, 8), root / "host" / "fxr" / "8.0.12-preview.1" / DOTOTHER_HOSTFXR_NAME);
+  EXPECT_EQ(FindHostFxrInRoot(root, 9), root / "host" / "fxr" / "9.0.0" / DOTOTHER_HOSTFXR_NAME);
+  EXPECT_FALSE(FindHostFxrInRoot(root, 7).has_value());
+  EXPECT_FALSE(FindHostFxrInRoot(root / "missing", 8).has_value());
+}
+
+TEST_F(HostFxrResolverTests, overrides_win) {
+  std::filesystem::path explicit_fxr = root / "host" / "fxr" / "8.0.1" / DOTOTHER_HOSTFXR_NAME;
+  EXPECT_EQ(ResolveHostFxr({ .hostfxr_path = explicit_fxr }), explicit_fxr);
+  EXPECT_EQ(ResolveHostFxr({ .dotnet_root = root, .major_version = 9 }), root / "host" / "fxr" / "9.0.0" / DOTOTHER_HOSTFXR_NAME);
+}
@@ -0,0 +1,209 @@
+/**
+ * \file Native/unit_tests/metadata_image_test.cpp
+ **/
+#include "core/dotest.hpp"
+
+#include <cstring>
+#include <filesystem>
+#include <string_view>
+#include <vector>
+
+#include "hosting/metadata_image.hpp"
+#include <gtest.h>
+
+using namespace dotother;
+
+class MetadataImageTests : public DoTest {
+  public:
+  protected:
+    /// header followed by a string table holding "" and "Mod1"
+    static std::vector<std::byte> MakeImage() {
+      constexpr uint32_t strings_offset = sizeof(metadata::Header);
+      const char name[] = "Mod1";
+      constexpr uint32_t name_len = sizeof(name) - 1;
+      constexpr uint32_t strings_size = 4 + 4 + name_len;
+
+      std::vector<std::byte> bytes(strings_offset + strings_size);
+
+      metadata::Header header{};
+      header.magic = metadata::kMagic;
+      header.version = metadata::kVersion;
+      header.size = static_cast<uint32_t>(bytes.size());
+      header.asm_name = 4;
+      header.strings = { strings_offset, strings_size };
+      std::memcpy(bytes.data(), &header, sizeof(header));
+
+      std::memcpy(bytes.data() + strings_offset + 4, &name_len, sizeof(name_len));
+      std::memcpy(bytes.data() + strings_offset + 8, name, name_len);
+      return bytes;
+    }
+
+    /// Mod1 : System.Object with a method, a field, a property and an attribute on the method, sections laid out
+    ///   behind the header 8 byte aligned like MetadataExport.Build does
+    static std::vector<std::byte> MakePopulatedImage() {
+      std::vector<std::byte> strings;
+      auto intern = [&](std::string_view str) {
+        uint32_t offset = static_cast<uint32_t>(strings.size());
+        uint32_t length = static_cast<uint32_t>(str.size());
+        strings.resize(strings.size() + sizeof(length) + length);
+        std::memcpy(strings.data() + offset, &length, sizeof(length));
+        std::memcpy(strings.data() + offset + sizeof(length), str.data(), length);
+        return offset;
+      };
+      intern("");
+
+      constexpr uint32_t object_ref = metadata::kExternalType | 0;
+
+      metadata::TypeRecord type{};
+      type.id = 10;
+      type.token = 0x02000002;
+      type.name = intern("Mod1");
+      type.full_name = intern("DotOther.Tests.Mod1");
+      type.nspace = intern("DotOther.Tests");
+      type.base_type = object_ref;
+      type.element_type = metadata::kNoType;
+      type.methods = { 0, 1 };
+      type.fields = { 0, 1 };
+      type.properties = { 0, 1 };
+      type.attributes = { 0, 0 };
+      type.ancestors = { 1, 1 };
+      type.interfaces = { 2, 0 };
+
+      metadata::ExternalTypeRecord object{ 11, intern("System.Object"), intern("System.Object, System.Private.CoreLib") };
+
+      metadata::MethodRecord method{};
+      method.id = 20;
+      method.token = 0x06000001;
+      method.declaring_type = 0;
+      method.name = intern("Move");
+      method.return_type = 0;
+      method.params = { 0, 1 };
+      method.signature = 0x1234;
+      method.attributes = { 0, 1 };
+
+      metadata::FieldRecord field{ 30, 0x04000001, 0, intern("number"), object_ref, 0, 0, { 0, 0 } };
+      metadata::PropertyRecord property{ 40, 0x17000001, 0, intern("MyInt"), object_ref };
+      metadata::AttributeRecord attribute{ 50, object_ref };
+      const uint32_t type_refs[] = { 0, object_ref };
+
+      std::vector<std::byte> bytes(sizeof(metadata::Header));
+      auto section = [&](const void* records, uint32_t count, size_t stride) {
+        bytes.resize((bytes.size() + 7) & ~size_t{ 7 });
+        metadata::Section res{ static_cast<uint32_t>(bytes.size()), count };
+        bytes.resize(bytes.size() + count * stride);
+        std::memcpy(bytes.data() + res.offset, records, count * stride);
+        return res;
+      };
+
+      metadata::Header header{};
+      header.magic = metadata::kMagic;
+      header.version = metadata::kVersion;
+      header.asm_id = 7;
+      header.asm_name = intern("Mod1");
+      header.key = { { 0xde, 0xad, 0xbe, 0xef }, 8, 0, 11 };
+      header.types = section(&type, 1, sizeof(type));
+      header.externals = section(&object, 1, sizeof(object));
+      header.methods = section(&method, 1, sizeof(method));
+      header.fields = section(&field, 1, sizeof(field));
+      header.properties = section(&property, 1, sizeof(property));
+      header.attributes = section(&attribute, 1, sizeof(attribute));
+      header.type_refs = section(type_refs, 2, sizeof(uint32_t));
+      header.strings = section(strings.data(), static_cast<uint32_t>(strings.size()), 1);
+      bytes.resize((bytes.size() + 7) & ~size_t{ 7 });
+      header.size = static_cast<uint32_t>(bytes.size());
+      std::memcpy(bytes.data(), &header, sizeof(header));
+      return bytes;
+    }
+};
+
+TEST_F(MetadataImageTests, rejects_malformed) {
+  auto bytes = MakeImage();
+  bytes[0] = std::byte{ 0 };
+  EXPECT_EQ(MetadataImage::FromBytes(std::move(bytes)), nullptr);
+
+  bytes = MakeImage();
+  bytes.resize(40);
+  EXPECT_EQ(MetadataImage::FromBytes(std::move(bytes)), nullptr);
+}
+
+TEST_F(MetadataImageTests, save_and_map_round_trip) {
+  ref<MetadataImage> image = MetadataImage::FromBytes(MakeImage());
+  ASSERT_NE(image, nullptr);
+  EXPECT_EQ(image->String(image->Header().asm_name), "Mod1");
+  EXPECT_TRUE(image->Types().empty());
+
+  std::filesystem::path path = std::filesystem::temp_directory_path() / "dotother_metadata_test.domd";
+  ASSERT_TRUE(image->Save(path));
+
+  {
+    ref<MetadataImage> mapped = MetadataImage::Map(path);
+    ASSERT_NE(mapped, nullptr);
+    EXPECT_EQ(mapped->Bytes().size(), image->Bytes().size());
+    EXPECT_EQ(mapped->String(mapped->Header().asm_name), "Mod1");
+  }
+
+  std::filesystem::remove(path);
+  EXPECT_EQ(MetadataImage::Map(path), nullptr);
+}
+
+TEST_F(MetadataImageTests, populated_image_round_trip) {
+  ref<MetadataImage> image = MetadataImage::FromBytes(MakePopulatedImage());
+  ASSERT_NE(image, nullptr);
+
+  std::filesystem::path path = std::filesystem::temp_directory_path() / "dotother_metadata_populated_test.domd";
+  ASSERT_TRUE(image->Save(path));
+
+  {
+    ref<MetadataImage> mapped = MetadataImage::Map(path);
+    ASSERT_NE(mapped, nullptr);
+
+    const auto& header = mapped->Header();
+    EXPECT_EQ(header.key, image->Header().key);
+    EXPECT_EQ(header.key.runtime_build, 11);
+    EXPECT_EQ(mapped->String(header.asm_name), "Mod1");
+    /// one id per type, external, member and attribute record
+    EXPECT_EQ(mapped->RecordCount(), 6);
+
+    ASSERT_EQ(mapped->Types().size(), 1);
+    const auto& type = mapped->Types()[0];
+    EXPECT_EQ(type.id, 10);
+    EXPECT_EQ(type.token, 0x02000002);
+    EXPECT_EQ(mapped->String(type.full_name), "DotOther.Tests.Mod1");
+    EXPECT_EQ(mapped->String(type.nspace), "DotOther.Tests");
+    EXPECT_EQ(mapped->TypeRefs()[type.ancestors.first], metadata::kExternalType | 0);
+
+    ASSERT_EQ(mapped->Externals().size(), 1);
+    EXPECT_EQ(mapped->String(mapped->Externals()[0].full_name), "System.Object");
+
+    ASSERT_EQ(mapped->Methods().size(), 1);
+    const auto& method = mapped->Methods()[0];
+    EXPECT_EQ(method.token, 0x06000001);
+    EXPECT_EQ(method.declaring_type, 0);
+    EXPECT_EQ(mapped->String(method.name), "Move");
+    EXPECT_EQ(method.signature, 0x1234);
+    EXPECT_EQ(mapped->TypeRefs()[method.params.first], 0);
+    EXPECT_EQ(mapped->Attributes()[method.attributes.first].id, 50);
+
+    ASSERT_EQ(mapped->Fields().size(), 1);
+    EXPECT_EQ(mapped->String(mapped->Fields()[0].name), "number");
+    ASSERT_EQ(mapped->Properties().size(), 1);
+    EXPECT_EQ(mapped->Properties()[0].token, 0x17000001);
+    EXPECT_EQ(mapped->String(mapped->Properties()[0].name), "MyInt");
+  }
+
+  std::filesystem::remove(path);
+}
+
+TEST_F(MetadataImageTests, rejects_out_of_range_members) {
+  auto bytes = MakePopulatedImage();
+  metadata::Header header;
+  std::memcpy(&header, bytes.data(), sizeof(header));
+
+  /// the type claims a second method the image does not have
+  metadata::TypeRecord type;
+  std::memcpy(&type, bytes.data() + header.types.offset, sizeof(type));
+  type.methods.count = 2;
+  std::memcpy(bytes.data() + header.types.offset, &type, sizeof(type));
+
+  EXPECT_EQ(MetadataImage::FromBytes(std::move(bytes)), nullptr);
+}
@@ -0,0 +1,89 @@
+/**
+ * \file Native/unit_tests/native_array_test.cpp
+ **/
+#include "core/dotest.hpp"
+
+#include "hosting/native_array.hpp"
+#include <gtest.h>
+
+using namespace dotother;
+
+struct Vec3 {
+  float x;
+  float y;
+  float z;
+};
+
+class NArrayTests : public DoTest {
+  public:
+  protected:
+    NArray<float> empty;
+};
+
+TEST_F(NArrayTests , default_ctor) {
+  EXPECT_EQ(empty.Size() , 0);
+  EXPECT_TRUE(empty.Empty());
+  EXPECT_FALSE(empty.IsOwner());
+  EXPECT_EQ(empty.Data() , nullptr);
+}
+
+TEST_F(NArrayTests , owning_copy) {
+  NArray<Vec3> arr{ { 1.f , 2.f , 3.f } , { 4.f , 5.f , 6.f } };
+  ASSERT_EQ(arr.Size() , 2);
+  ASSERT_TRUE(arr.IsOwner());
+
+  ASSERT_EQ(arr[1].x , 4.f);
+  ASSERT_EQ(arr[1].z , 6.f);
+
+  NArray<Vec3> clone = arr.Clone();
+  ASSERT_NE(clone.Data() , arr.Data());
+  ASSERT_EQ(clone[0].y , 2.f);
+}
+
+TEST_F(NArrayTests , view_does_not_own) {
+  float storage[4] = { 1.f , 2.f , 3.f , 4.f };
+  {
+    NArray<float> view = NArray<float>::View(storage , 4);
+    ASSERT_FALSE(view.IsOwner());
+    ASSERT_EQ(view.Data() , storage);
+
+    view[0] = 10.f;
+  }
+  ASSERT_EQ(storage[0] , 10.f);
+}
+
+TEST_F(NArrayTests , move_transfers_ownership) {
+  NArray<int32_t> arr(8);
+  int32_t* data = arr.Data();
+
+  NArray<int32_t> moved = std::move(arr);
+  ASSERT_EQ(moved.Data() , data);
+  ASSERT_TRUE(moved.IsOwner());
+  ASSERT_FALSE(arr.IsOwner());
+  ASSERT_EQ(arr.Size() , 0);
+}
+
+TEST_F(NArrayTests , span_access) {
+  NArray<int32_t> arr{ 1 , 2 , 3 , 4 , 5 };
+
+  int32_t sum = 0;
+  for (auto i : arr.Subspan(1 , 3)) {
+    sum += i;
+  }
+  ASSERT_EQ(sum , 9);
+
+  std::span<const int32_t> span = arr;
+  ASSERT_EQ(span.size() , arr.Size());
+}
+
+TEST_F(NArrayTests , object_elements_start_empty) {
+  NArray<HostedObject> arr(3);
+  ASSERT_TRUE(arr.IsOwner());
+  for (const auto& obj : arr) {
+    ASSERT_FALSE(obj.IsValid());
+  }
+
+  NArray<HostedObject> moved = std::move(arr);
+  ASSERT_EQ(moved.Size() , 3);
+  ASSERT_EQ(arr.Data() , nullptr);
+}
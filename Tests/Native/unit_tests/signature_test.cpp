@@ -0,0 +1,73 @@
+/**
+ * \file Native/unit_tests/signature_test.cpp
+ **/
+#include "core/dotest.hpp"
+
+#include "core/utilities.hpp"
+#include "hosting/native_array.hpp"
+#include "hosting/native_string.hpp"
+#include <gtest.h>
+
+using namespace dotother;
+
+enum class Color : uint16_t {
+  RED,
+  GREEN,
+};
+
+struct Vec3 {
+  float x;
+  float y;
+  float z;
+};
+
+struct Vec4 {
+  float x;
+  float y;
+  float z;
+  float w;
+};
+
+DOTOTHER_MANAGED_STRUCT(Vec3, "DotOther.Tests.Vec3");
+DOTOTHER_MANAGED_STRUCT(Vec4, "DotOther.Tests.Vec4");
+
+class SignatureTests : public DoTest {
+  public:
+  protected:
+    virtual void SetUp() override {}
+    virtual void TearDown() override {}
+};
+
+TEST_F(SignatureTests, kinds) {
+  static_assert(util::GetManagedType<int32_t>() == ManagedType::INT);
+  static_assert(util::GetManagedType<const uint64_t&>() == ManagedType::ULONG);
+  static_assert(util::GetManagedType<long long>() == ManagedType::LONG);
+  static_assert(util::GetManagedType<Color>() == ManagedType::USHORT);
+  static_assert(util::GetManagedType<float*>() == ManagedType::POINTER);
+  static_assert(util::GetManagedType<NString>() == ManagedType::STRING);
+  static_assert(util::GetManagedType<NArray<float>>() == ManagedType::ARRAY);
+  static_assert(util::GetManagedType<HostedObject&>() == ManagedType::OBJECT);
+}
+
+TEST_F(SignatureTests, hash_is_order_and_arity_sensitive) {
+  static_assert(util::SignatureHash<int32_t, float>() != util::SignatureHash<float, int32_t>());
+  static_assert(util::SignatureHash<int32_t>() != util::SignatureHash<int32_t, int32_t>());
+  static_assert(util::SignatureHash<>() != util::SignatureHash<int32_t>());
+  static_assert(util::SignatureHash<int32_t&, const float&>() == util::SignatureHash<int32_t, float>());
+}
+
+TEST_F(SignatureTests, struct_params) {
+  static_assert(util::GetManagedType<const Vec3&>() == ManagedType::STRUCT);
+  static_assert(util::GetParamSignature<Vec3>().size == sizeof(Vec3));
+  static_assert(util::GetParamSignature<Vec3>().type_hash == util::HashString("DotOther.Tests.Vec3"));
+  static_assert(util::SignatureHash<Vec3>() != util::SignatureHash<Vec4>());
+}
+
+TEST_F(SignatureTests, empty_signature) {
+  /// FNV-1a over a single little endian zero int32, managed computes the same value for a parameterless method
+  uint64_t expected = util::kFnvOffsetBasis;
+  for (int i = 0; i < 4; ++i) {
+    expected *= util::kFnvPrime;
+  }
+  EXPECT_EQ(util::SignatureHash<>(), expected);
+}
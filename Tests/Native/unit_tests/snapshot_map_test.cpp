@@ -0,0 +1,110 @@
+/**
+ * \file Native/unit_tests/snapshot_map_test.cpp
+ **/
+#include "core/dotest.hpp"
+
+#include <atomic>
+#include <string>
+#include <string_view>
+#include <thread>
+
+#include "core/snapshot_map.hpp"
+#include "core/utilities.hpp"
+#include <gtest.h>
+
+using namespace dotother;
+using namespace std::string_view_literals;
+
+class SnapshotMapTests : public DoTest {};
+
+TEST_F(SnapshotMapTests, reads_see_committed_inserts) {
+  SnapshotMap<int32_t, int32_t> map;
+  EXPECT_EQ(map.Find(1), 0);
+
+  {
+    SnapshotMap<int32_t, int32_t>::Writer writer(map);
+    EXPECT_TRUE(writer.Insert(1, 10));
+    EXPECT_TRUE(writer.Insert(2, 20));
+    /// an existing key keeps its value
+    EXPECT_FALSE(writer.Insert(1, 11));
+  }
+
+  EXPECT_EQ(map.Find(1), 10);
+  EXPECT_EQ(map.Find(2), 20);
+  EXPECT_EQ(map.Size(), 2);
+}
+
+TEST_F(SnapshotMapTests, staged_writes_stay_private_until_commit) {
+  SnapshotMap<int32_t, int32_t> map;
+  {
+    SnapshotMap<int32_t, int32_t>::Writer writer(map);
+    writer.Insert(1, 10);
+  }
+
+  SnapshotMap<int32_t, int32_t>::Writer writer(map);
+  writer.Insert(2, 20);
+  writer.Erase(1);
+
+  /// the writer reads its own staged shards, everyone else still reads the old snapshot
+  EXPECT_EQ(writer.Find(2), 20);
+  EXPECT_EQ(writer.Find(1), 0);
+  EXPECT_EQ(map.Find(1), 10);
+  EXPECT_EQ(map.Find(2), 0);
+  EXPECT_EQ(map.Size(), 1);
+
+  writer.Commit();
+  EXPECT_EQ(map.Find(1), 0);
+  EXPECT_EQ(map.Find(2), 20);
+  EXPECT_EQ(map.Size(), 1);
+}
+
+TEST_F(SnapshotMapTests, transparent_lookup) {
+  SnapshotMap<std::string_view, int32_t, util::StringHash, std::equal_to<>> map;
+  {
+    decltype(map)::Writer writer(map);
+    writer.Insert("DotOther.Tests.Mod1"sv, 1);
+  }
+
+  std::string name = "DotOther.Tests.Mod1";
+  EXPECT_EQ(map.Find(std::string_view(name)), 1);
+  EXPECT_EQ(map.Find("DotOther.Tests.Mod2"sv), 0);
+}
+
+TEST_F(SnapshotMapTests, concurrent_reads_keep_committed_entries) {
+  constexpr int32_t kKept = 64;
+  constexpr int32_t kBatches = 200;
+
+  SnapshotMap<int32_t, int32_t> map;
+  {
+    SnapshotMap<int32_t, int32_t>::Writer writer(map);
+    for (int32_t i = 0; i < kKept; ++i) {
+      writer.Insert(i, i + 1);
+    }
+  }
+
+  std::atomic<bool> done = false;
+  std::atomic<int32_t> lost = 0;
+
+  /// writers replace whole shards, a reader racing them must still find every key committed before
+  std::jthread reader([&] {
+    while (!done.load(std::memory_order_acquire)) {
+      for (int32_t i = 0; i < kKept; ++i) {
+        if (map.Find(i) != i + 1) {
+          lost.fetch_add(1, std::memory_order_relaxed);
+        }
+      }
+    }
+  });
+
+  for (int32_t b = 0; b < kBatches; ++b) {
+    SnapshotMap<int32_t, int32_t>::Writer writer(map);
+    for (int32_t i = 0; i < 16; ++i) {
+      writer.Insert(kKept + b * 16 + i, 1);
+    }
+  }
+  done.store(true, std::memory_order_release);
+  reader.join();
+
+  EXPECT_EQ(lost.load(), 0);
+  EXPECT_EQ(map.Size(), static_cast<size_t>(kKept + kBatches * 16));
+}
@@ -0,0 +1,61 @@
+/**
+ * \file Native/unit_tests/startup_profile_test.cpp
+ **/
+#include "core/dotest.hpp"
+
+#include "hosting/startup_profile.hpp"
+#include <gtest.h>
+
+using namespace dotother;
+
+class StartupProfileTests : public DoTest {
+  public:
+  protected:
+    virtual void SetUp() override {
+      StartupProfile::Instance().Reset();
+    }
+};
+
+TEST_F(StartupProfileTests, scopes_accumulate_time_and_interop_calls) {
+  auto& profile = StartupProfile::Instance();
+  for (int run = 0; run < 2; ++run) {
+    StartupProfile::Scope timing(StartupPhase::IMPORT_TYPES);
+    for (int i = 0; i < 3; ++i) {
+      profile.CountInteropCall();
+    }
+  }
+
+  StartupReport report = profile.Report();
+  EXPECT_EQ(report[StartupPhase::IMPORT_TYPES].runs, 2);
+  EXPECT_EQ(report[StartupPhase::IMPORT_TYPES].interop_calls, 6);
+  EXPECT_GT(report[StartupPhase::IMPORT_TYPES].wall_ns, 0);
+  EXPECT_EQ(report[StartupPhase::HOST_PATH].runs, 0);
+  EXPECT_EQ(report.TotalInteropCalls(), 6);
+  EXPECT_FALSE(report.has_managed);
+}
+
+TEST_F(StartupProfileTests, calls_outside_a_scope_are_not_counted) {
+  auto& profile = StartupProfile::Instance();
+  uint64_t before = profile.InteropCalls();
+  for (int i = 0; i < 3; ++i) {
+    profile.CountInteropCall();
+  }
+  EXPECT_EQ(profile.InteropCalls(), before);
+
+  {
+    StartupProfile::Scope timing(StartupPhase::LOAD_ASSEMBLY);
+    profile.CountInteropCall();
+  }
+  profile.CountInteropCall();
+
+  EXPECT_EQ(profile.InteropCalls(), before + 1);
+  EXPECT_EQ(profile.Report()[StartupPhase::LOAD_ASSEMBLY].interop_calls, 1);
+}
+
+TEST_F(StartupProfileTests, json_names_every_phase) {
+  std::string json = StartupProfile::Instance().Report().ToJson();
+  for (size_t i = 0; i < static_cast<size_t>(StartupPhase::COUNT); ++i) {
+    EXPECT_NE(json.find(PhaseName(static_cast<StartupPhase>(i))), std::string::npos);
+  }
+  EXPECT_EQ(json.find("\"managed\""), std::string::npos);
+}
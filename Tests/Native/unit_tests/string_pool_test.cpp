@@ -0,0 +1,45 @@
+/**
+ * \file Native/unit_tests/string_pool_test.cpp
+ **/
+#include "core/dotest.hpp"
+
+#include <string>
+#include <vector>
+
+#include "core/string_pool.hpp"
+#include <gtest.h>
+
+using namespace dotother;
+
+class StringPoolTests : public DoTest {
+  public:
+  protected:
+    virtual void SetUp() override {}
+    virtual void TearDown() override {}
+};
+
+TEST_F(StringPoolTests, equal_strings_share_storage) {
+  std::string name = "DotOther.Tests.Mod1";
+  std::string_view first = StringPool::Instance().Intern(name);
+  std::string_view second = StringPool::Instance().Intern(std::string(name));
+
+  EXPECT_EQ(first, name);
+  EXPECT_EQ(first.data(), second.data());
+  EXPECT_NE(first.data(), name.data());
+  EXPECT_TRUE(StringPool::Instance().Intern("").empty());
+}
+
+TEST_F(StringPoolTests, views_survive_growth) {
+  std::string_view early = StringPool::Instance().Intern("StringPoolTests.Early");
+
+  /// enough names to spill into several blocks
+  std::vector<std::string_view> views;
+  for (size_t i = 0; i < 20000; ++i) {
+    views.push_back(StringPool::Instance().Intern("StringPoolTests.Name" + std::to_string(i)));
+  }
+
+  EXPECT_EQ(early, "StringPoolTests.Early");
+  for (size_t i = 0; i < views.size(); ++i) {
+    EXPECT_EQ(views[i], "StringPoolTests.Name" + std::to_string(i));
+  }
+}
@@ -0,0 +1,119 @@
+/**
+ * \file Native/unit_tests/type_cache_test.cpp
+ **/
+#include "core/dotest.hpp"
+
+#include "core/utilities.hpp"
+#include "hosting/type.hpp"
+#include "hosting/type_cache.hpp"
+#include <gtest.h>
+
+using namespace dotother;
+using namespace std::string_view_literals;
+
+class TypeCacheTests : public DoTest {
+  public:
+  protected:
+    virtual void SetUp() override {}
+    virtual void TearDown() override {}
+};
+
+TEST_F(TypeCacheTests, split_type_name) {
+  static_assert(util::SplitTypeName("DotOther.Tests.Mod1") == std::pair{ "DotOther.Tests"sv, "Mod1"sv });
+  static_assert(util::SplitTypeName("Mod1") == std::pair{ ""sv, "Mod1"sv });
+  static_assert(util::SplitTypeName("A.B.Outer+Inner") == std::pair{ "A.B"sv, "Outer+Inner"sv });
+  static_assert(util::SplitTypeName("System.Collections.Generic.List`1[[System.Int32, System.Private.CoreLib]]") ==
+                std::pair{ "System.Collections.Generic"sv, "List`1[[System.Int32, System.Private.CoreLib]]"sv });
+}
+
+TEST_F(TypeCacheTests, key_hash_is_assembly_scoped) {
+  constexpr TypeKeyView mod1{ 1, "DotOther.Tests", "Mod1" };
+  constexpr TypeKeyView other_asm{ 2, "DotOther.Tests", "Mod1" };
+  constexpr TypeKeyView moved{ 1, "DotOther", "Tests.Mod1" };
+
+  static_assert(mod1.Hash() != other_asm.Hash());
+  static_assert(mod1.Hash() != moved.Hash());
+  static_assert(TypeKeyView{ 1, "AB", "C" }.Hash() != TypeKeyView{ 1, "A", "BC" }.Hash());
+
+  TypeKey key{ 1, "DotOther.Tests", "Mod1", mod1.Hash() };
+  EXPECT_EQ(TypeKeyHash{}(key), TypeKeyHash{}(mod1));
+  EXPECT_TRUE(TypeKeyEqual{}(key, mod1));
+  EXPECT_FALSE(TypeKeyEqual{}(key, other_asm));
+}
+
+TEST_F(TypeCacheTests, evict_forgets_only_the_given_types) {
+  auto& cache = TypeCache::Instance();
+  Type* kept = cache.CacheType(Type(910001), "Evict.Tests.Kept", "Evict.Tests", 910000);
+  Type* dropped = cache.CacheType(Type(910002), "Evict.Tests.Dropped", "Evict.Tests", 910000);
+  ASSERT_NE(kept, nullptr);
+  ASSERT_NE(dropped, nullptr);
+
+  const int32_t ids[] = { 910002 };
+  cache.Evict(ids);
+
+  EXPECT_EQ(cache.FindType(910002), nullptr);
+  EXPECT_EQ(cache.GetType("Evict.Tests.Dropped"sv), nullptr);
+  EXPECT_EQ(cache.GetType(TypeKeyView{ 910000, "Evict.Tests", "Dropped" }), nullptr);
+  EXPECT_EQ(dropped->handle, -1);
+
+  EXPECT_EQ(cache.FindType(910001), kept);
+  EXPECT_EQ(cache.GetType(TypeKeyView{ 910000, "Evict.Tests", "Kept" }), kept);
+}
+
+TEST_F(TypeCacheTests, qualify_needs_a_dotted_namespace_prefix) {
+  auto& cache = TypeCache::Instance();
+  Type* nested = cache.CacheType(Type(910011), "Qualify.Tests.Outer+Inner", "Qualify.Tests", 910010);
+  Type* prefixed = cache.CacheType(Type(910012), "Qualify.TestsX.Other", "Qualify.Tests", 910010);
+  ASSERT_NE(nested, nullptr);
+  ASSERT_NE(prefixed, nullptr);
+
+  EXPECT_EQ(cache.GetType(TypeKeyView{ 910010, "Qualify.Tests", "Outer+Inner" }), nested);
+
+  /// the namespace only matches the characters, not a segment, the name is not cut
+  EXPECT_EQ(cache.GetType(TypeKeyView{ 910010, "Qualify.Tests", ".Other" }), nullptr);
+  EXPECT_EQ(cache.GetType(TypeKeyView{ 910010, "Qualify.Tests", "Qualify.TestsX.Other" }), prefixed);
+}
+
+TEST_F(TypeCacheTests, batch_is_invisible_until_published) {
+  auto& cache = TypeCache::Instance();
+  Type* published = cache.CacheType(Type(910021), "Batch.Tests.Published", "Batch.Tests", 910020);
+  ASSERT_NE(published, nullptr);
+
+  TypeCache::Batch batch;
+  /// an external reference stages the type first, the later import of its own assembly still claims it
+  const TypeCache::PendingType referenced[] = { { 910022, "Batch.Tests.Staged", "Batch.Tests" } };
+  const TypeCache::PendingType own[] = {
+    { 910022, "Batch.Tests.Staged", "Batch.Tests", 910020 },
+    { 910021, "Batch.Tests.Published", "Batch.Tests", 910020 },
+  };
+
+  std::vector<bool> owned;
+  std::vector<Type*> first = cache.CacheTypes(referenced, batch, &owned);
+  EXPECT_EQ(owned, std::vector<bool>{ false });
+  std::vector<Type*> second = cache.CacheTypes(own, batch, &owned);
+  EXPECT_EQ(owned, (std::vector<bool>{ true, false }));
+  ASSERT_EQ(second.size(), 2u);
+  EXPECT_EQ(second[0], first[0]);
+  EXPECT_EQ(second[1], published);
+
+  EXPECT_EQ(cache.FindType(910022), nullptr);
+  EXPECT_EQ(cache.GetType(TypeKeyView{ 910020, "Batch.Tests", "Staged" }), nullptr);
+
+  cache.Publish(batch);
+  EXPECT_EQ(cache.FindType(910022), first[0]);
+  EXPECT_EQ(cache.GetType(TypeKeyView{ 910020, "Batch.Tests", "Staged" }), first[0]);
+  EXPECT_EQ(cache.FindType(910021), published);
+}
+
+TEST_F(TypeCacheTests, dropped_batch_stays_unpublished) {
+  auto& cache = TypeCache::Instance();
+  {
+    TypeCache::Batch batch;
+    const TypeCache::PendingType pending[] = { { 910031, "Batch.Tests.Dropped", "Batch.Tests", 910030 } };
+    ASSERT_NE(cache.CacheTypes(pending, batch)[0], nullptr);
+  }
+
+  EXPECT_EQ(cache.FindType(910031), nullptr);
+  EXPECT_EQ(cache.GetType("Batch.Tests.Dropped"sv), nullptr);
+  EXPECT_EQ(cache.GetType(TypeKeyView{ 910030, "Batch.Tests", "Dropped" }), nullptr);
+}
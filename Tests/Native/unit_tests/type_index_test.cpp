@@ -0,0 +1,67 @@
+/**
+ * \file Native/unit_tests/type_index_test.cpp
+ **/
+#include "core/dotest.hpp"
+
+#include <string>
+#include <vector>
+
+#include "hosting/type_index.hpp"
+#include <gtest.h>
+
+using namespace dotother;
+
+class TypeIndexTests : public DoTest {
+  public:
+  protected:
+    virtual void SetUp() override {
+      for (size_t i = 0; i < 5000; ++i) {
+        names.push_back("Game.Ns" + std::to_string(i % 7) + ".Component" + std::to_string(i));
+      }
+      names.push_back("Game.Ns0.Outer+Inner");
+      names.push_back("Global");
+
+      std::vector<TypeIndex::Entry> entries;
+      for (size_t i = 0; i < names.size(); ++i) {
+        entries.push_back({ names[i], Fake(i) });
+      }
+      index = TypeIndex::Build(entries);
+    }
+
+    /// the index never dereferences its types, any unique address will do
+    static Type* Fake(size_t i) {
+      return reinterpret_cast<Type*>(i + 1);
+    }
+
+    std::vector<std::string> names;
+    TypeIndex index;
+};
+
+TEST_F(TypeIndexTests, every_name_maps_to_its_type) {
+  ASSERT_EQ(index.Size(), names.size());
+  for (size_t i = 0; i < names.size(); ++i) {
+    EXPECT_EQ(index.Find(names[i]), Fake(i));
+  }
+}
+
+TEST_F(TypeIndexTests, misses) {
+  EXPECT_EQ(index.Find("Game.Ns0.Missing"), nullptr);
+  EXPECT_EQ(index.Find(""), nullptr);
+  EXPECT_EQ(index.Find("Game.Ns1", "Component0"), nullptr);
+  EXPECT_EQ(TypeIndex{}.Find("Global"), nullptr);
+}
+
+TEST_F(TypeIndexTests, split_lookup) {
+  EXPECT_EQ(index.Find("Game.Ns3", "Component3"), Fake(3));
+  EXPECT_EQ(index.Find("Game.Ns0", "Outer+Inner"), Fake(5000));
+  EXPECT_EQ(index.Find("", "Global"), Fake(5001));
+}
+
+TEST_F(TypeIndexTests, prefix_and_namespace) {
+  auto in_ns0 = index.InNamespace("Game.Ns0");
+  EXPECT_EQ(in_ns0.size(), 716);
+  EXPECT_EQ(index.WithPrefix("Game.Ns0.").size(), 716);
+  EXPECT_EQ(index.WithPrefix("Game.").size(), 5001);
+  EXPECT_EQ(index.InNamespace("Game").size(), 0);
+  EXPECT_EQ(index.InNamespace("").size(), 1);
+}